@@ -3,5 +3,6 @@
 #include "Climbing.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogZCClimbing);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Climbing, "Climbing" );
- 
\ No newline at end of file
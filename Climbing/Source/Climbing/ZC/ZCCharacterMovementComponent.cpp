@@ -3,9 +3,20 @@
 
 #include "Climbing/ZC/ZCCharacterMovementComponent.h"
 #include "Climbing/ZC/ZCTypes.h"
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbGrid.h"
+#include "Climbing/ZC/ZCLedgeGraph.h"
+#include "Climbing/ZC/ZCClimbMotionProfile.h"
+#include "Climbing/ZC/ZCClimbingBatch.h"
+#include "Climbing/Climbing.h"
 
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "EngineUtils.h"
+#include "Net/UnrealNetwork.h"
 
 static TAutoConsoleVariable<bool> CVarDebugToggle(
 	TEXT("DebugToggle"),
@@ -15,6 +26,148 @@ static TAutoConsoleVariable<bool> CVarDebugToggle(
 	TEXT("1: on"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<bool> CVarProxyClimbingProbes(
+	TEXT("ZC.ClimbState.ProxyProbes"),
+	false,
+	TEXT("Simulated proxies run their own climbing queries instead of following the replicated climbing state\n")
+	TEXT("0: follow the replicated state\n")
+	TEXT("1: probe, for comparison"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarClimbTickQueryBudget(
+	TEXT("ZC.Budget.QueriesPerClimbTick"),
+	0,
+	TEXT("Scene queries a character may issue in one climbing tick before it counts as over budget\n")
+	TEXT("0: no limit"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarClimbTickTimeBudget(
+	TEXT("ZC.Budget.ClimbTickMicroseconds"),
+	0.f,
+	TEXT("Game thread time a character may spend in one climbing tick (wall sweep plus PhysClimbing) before it counts as over budget\n")
+	TEXT("0: no limit"),
+	ECVF_Default);
+
+void FSavedMove_ZCCharacter::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToClimb = false;
+	bSavedWantsToClimbDash = false;
+	SavedClimbDashTime = 0.f;
+	SavedClimbDashDirection = FVector::ZeroVector;
+	SavedClimbingTimeAccumulator = 0.f;
+	bSavedHasClimbStartClaim = false;
+	SavedClimbStartClaim = FZCClimbContactClaim();
+}
+
+uint8 FSavedMove_ZCCharacter::GetCompressedFlags() const
+{
+	uint8 Flags = Super::GetCompressedFlags();
+
+	if (bSavedWantsToClimb)
+		Flags |= FLAG_WantsToClimb;
+	if (bSavedWantsToClimbDash)
+		Flags |= FLAG_WantsToClimbDash;
+
+	return Flags;
+}
+
+bool FSavedMove_ZCCharacter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	// Moves can still combine while climbing or dashing, just not across a change in either
+	const FSavedMove_ZCCharacter* NewZCMove = static_cast<const FSavedMove_ZCCharacter*>(NewMove.Get());
+	if (bSavedWantsToClimb != NewZCMove->bSavedWantsToClimb || bSavedWantsToClimbDash != NewZCMove->bSavedWantsToClimbDash || bSavedHasClimbStartClaim != NewZCMove->bSavedHasClimbStartClaim)
+		return false;
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_ZCCharacter::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	if (const UZCCharacterMovementComponent* Movement = Cast<UZCCharacterMovementComponent>(C->GetCharacterMovement()))
+	{
+		bSavedWantsToClimb = Movement->bWantsToClimb;
+		bSavedWantsToClimbDash = Movement->bWantsToClimbDash;
+		SavedClimbDashTime = Movement->CurrentClimbDashTime;
+		SavedClimbDashDirection = Movement->ClimbDashDirection;
+		SavedClimbingTimeAccumulator = Movement->ClimbingTimeAccumulator;
+
+		// Once climbing the server has nothing left to check
+		bSavedHasClimbStartClaim = Movement->bHasClimbStartClaim && Movement->bWantsToClimb && !Movement->IsClimbing();
+		SavedClimbStartClaim = Movement->ClimbStartClaim;
+	}
+}
+
+void FSavedMove_ZCCharacter::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	if (UZCCharacterMovementComponent* Movement = Cast<UZCCharacterMovementComponent>(C->GetCharacterMovement()))
+	{
+		Movement->bWantsToClimb = bSavedWantsToClimb;
+		Movement->bWantsToClimbDash = bSavedWantsToClimbDash;
+		Movement->bLastClientClimbDashFlag = bSavedWantsToClimbDash;
+		Movement->CurrentClimbDashTime = SavedClimbDashTime;
+		Movement->ClimbDashDirection = SavedClimbDashDirection;
+		Movement->ClimbingTimeAccumulator = SavedClimbingTimeAccumulator;
+	}
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_ZCCharacter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_ZCCharacter());
+}
+
+void FZCCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_ZCCharacter& ZCMove = static_cast<const FSavedMove_ZCCharacter&>(ClientMove);
+	bHasClimbStartClaim = ZCMove.bSavedHasClimbStartClaim;
+	ClimbStartPosition = ZCMove.SavedClimbStartClaim.Position;
+	ClimbStartNormal = ZCMove.SavedClimbStartClaim.Normal;
+}
+
+bool FZCCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// A single bit on every move that isn't a climb start
+	Ar.SerializeBits(&bHasClimbStartClaim, 1);
+	if (bHasClimbStartClaim)
+	{
+		bool bLocalSuccess = true;
+		ClimbStartPosition.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		ClimbStartNormal.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	}
+
+	return !Ar.IsError();
+}
+
+FZCCharacterNetworkMoveDataContainer::FZCCharacterNetworkMoveDataContainer()
+{
+	NewMoveData = &MoveDataStorage[0];
+	PendingMoveData = &MoveDataStorage[1];
+	OldMoveData = &MoveDataStorage[2];
+}
+
+UZCCharacterMovementComponent::UZCCharacterMovementComponent()
+{
+	SetNetworkMoveDataContainer(NetworkMoveDataContainer);
+	SetIsReplicatedByDefault(true);
+}
+
+void UZCCharacterMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The owning client simulates climbing itself
+	DOREPLIFETIME_CONDITION(UZCCharacterMovementComponent, ReplicatedClimbState, COND_SimulatedOnly);
+}
+
 bool UZCCharacterMovementComponent::IsClimbing() const
 {
 	return MovementMode == EMovementMode::MOVE_Custom && CustomMovementMode == ECustomMovementMode::CMOVE_Climbing;
@@ -25,12 +178,11 @@ void UZCCharacterMovementComponent::TryClimbDashing()
 	if (!IsClimbing())
 		return;
 
-	if (ClimbDashCurve && !bWantsToClimbDash)
+	// The direction is picked on the dash's first step, see UpdateClimbDashState
+	if (CanClimbDash() && !bWantsToClimbDash)
 	{
 		bWantsToClimbDash = true;
 		CurrentClimbDashTime = 0.f;
-
-		CacheClimbDashDirection();
 	}
 }
 
@@ -39,10 +191,66 @@ FVector UZCCharacterMovementComponent::GetClimbSurfaceNormal() const
 	return CurrentClimbingNormal;
 }
 
+float UZCCharacterMovementComponent::GetWallSweepSkipRatio() const
+{
+	const int32 Total = WallSweepsRun + WallSweepsSkipped;
+	return Total > 0 ? static_cast<float>(WallSweepsSkipped) / Total : 0.f;
+}
+
+float UZCCharacterMovementComponent::GetWallSweepTrackedRatio() const
+{
+	const int32 Total = WallSweepsRun + WallSweepsTracked;
+	return Total > 0 ? static_cast<float>(WallSweepsTracked) / Total : 0.f;
+}
+
+float UZCCharacterMovementComponent::GetQueryCacheHitRate() const
+{
+	const int32 Total = QueryCounters.CacheHits + QueryCounters.CacheMisses;
+	return Total > 0 ? static_cast<float>(QueryCounters.CacheHits) / Total : 0.f;
+}
+
 void UZCCharacterMovementComponent::WantsClimbing()
 {
+	if (bWantsToClimb)
+		return;
+
+	// Geometry may have moved in since the last proximity check or the hits are from a few ticks ago, so don't trust a skipped sweep
+	if (bWallHitsStale)
+	{
+		bHasProximityResult = false;
+		SweepAndStoreWallHits();
+	}
+
+	bWantsToClimb = CanStartClimbing();
+	UpdateClimbStartClaim();
+}
+
+void UZCCharacterMovementComponent::UpdateClimbStartClaim()
+{
+	bHasClimbStartClaim = false;
 	if (!bWantsToClimb)
-		bWantsToClimb = CanStartClimbing();
+		return;
+
+	// The server runs the same facing check on it, so any contact that passes will do
+	for (const FZCClimbContact& WallContact : CurrentWallContacts)
+	{
+		if (HorizontalClimbCheck(WallContact))
+		{
+			ClimbStartClaim = { WallContact.ImpactPoint, WallContact.Normal };
+			bHasClimbStartClaim = true;
+			return;
+		}
+	}
+}
+
+void UZCCharacterMovementComponent::SetClimbingLOD(EZCClimbingLOD NewLOD)
+{
+	if (ClimbingLOD == NewLOD)
+		return;
+
+	ClimbingLOD = NewLOD;
+	bForceClimbingLODRefresh = true;
+	bForceClimbingStepRefresh = true;
 }
 
 void UZCCharacterMovementComponent::CancelClimbing()
@@ -54,21 +262,161 @@ void UZCCharacterMovementComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	AnimInstance = GetCharacterOwner()->GetMesh()->GetAnimInstance();
+	if (USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr)
+		Mesh->OnAnimInitialized.AddUniqueDynamic(this, &UZCCharacterMovementComponent::BindAnimInstance);
+	BindAnimInstance();
 
 	// Don't want to sweep ourselves
 	ClimbQueryParams.AddIgnoredActor(GetOwner());
+	ClimbTraceChannel = UZCClimbingSettings::GetClimbTraceChannel();
+
+	MinHorizontalClimbAngleCos = FMath::Cos(FMath::DegreesToRadians(MinHorizontalDegreesToStartClimbing));
+	ContactReprobeAngleCos = FMath::Cos(FMath::DegreesToRadians(ContactReprobeAngle));
+	ClimbClaimAngleCos = FMath::Cos(FMath::DegreesToRadians(ClimbClaimAngleTolerance));
+
+	float MinTime = 0.f;
+	if (ClimbMotionProfile)
+	{
+		ClimbMotionProfile->ConditionalBakeTables();
+		ClimbDashEndTime = ClimbMotionProfile->GetDashEndTime();
+	}
+	else if (ClimbDashCurve)
+	{
+		ClimbDashCurve->GetTimeRange(MinTime, ClimbDashEndTime);
+	}
+
+	if (bUseClimbGrid)
+		for (TActorIterator<AZCClimbGrid> It(GetWorld()); It; ++It)
+			ClimbGrids.Add(*It);
+
+	if (bUseLedgeGraph)
+		for (TActorIterator<AZCLedgeGraph> It(GetWorld()); It; ++It)
+			LedgeGraphs.Add(*It);
+
+	if (bUseBatchedClimbingTick)
+		if (UZCClimbingBatchSubsystem* Batch = GetWorld()->GetSubsystem<UZCClimbingBatchSubsystem>())
+		{
+			Batch->RegisterClimber(this);
+			bIsClimbingTickBatched = true;
+
+			if (bUseAsyncClimbingQueries)
+				UE_LOG(LogZCClimbing, Warning, TEXT("%s uses the batched climbing tick, its climbing queries will be blocking rather than async"), *GetNameSafe(GetOwner()));
+		}
+}
+
+void UZCCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bIsClimbingTickBatched)
+		if (UZCClimbingBatchSubsystem* Batch = GetWorld()->GetSubsystem<UZCClimbingBatchSubsystem>())
+			Batch->UnregisterClimber(this);
+	bIsClimbingTickBatched = false;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UZCCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	++ClimbingLODFrame;
+
+	const bool bWasClimbing = IsClimbing();
+	const int32 QueriesBefore = ClimbingProfile.GetNumQueries();
+	const uint64 CyclesBefore = ClimbingProfile.StageCycles[static_cast<int32>(EZCClimbStage::WallSweep)] + ClimbingProfile.StageCycles[static_cast<int32>(EZCClimbStage::PhysClimbing)];
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	SweepAndStoreWallHits();
+	if (IsFollowingReplicatedClimbState())
+	{
+		FollowReplicatedClimbState(DeltaTime);
+	}
+	// Batched components get swept by UZCClimbingBatchSubsystem once every climber has moved
+	else if (!bIsClimbingTickBatched)
+	{
+		if (ShouldRunClimbingLODStage(GetClimbingLODSettings().WallSweepInterval))
+			SweepAndStoreWallHits();
+		else
+			bWallHitsStale = true;
+	}
+
+	if (bWasClimbing || IsClimbing())
+	{
+		INC_DWORD_STAT(STAT_ZCActiveClimbers);
+
+		const uint64 CyclesAfter = ClimbingProfile.StageCycles[static_cast<int32>(EZCClimbStage::WallSweep)] + ClimbingProfile.StageCycles[static_cast<int32>(EZCClimbStage::PhysClimbing)];
+		CheckClimbTickBudget(ClimbingProfile.GetNumQueries() - QueriesBefore, CyclesAfter - CyclesBefore);
+	}
+
+	// The batch still needs to see the forced refresh for its sweep, it clears it itself
+	if (!bIsClimbingTickBatched)
+		bForceClimbingLODRefresh = false;
+
+	UpdateClimbingMeshInterpolation();
 
 	if (bIsDebugEnabled != CVarDebugToggle.GetValueOnAnyThread())
 		bIsDebugEnabled = CVarDebugToggle.GetValueOnAnyThread();
 
+	PublishReplicatedClimbState();
+	PublishClimbingAnimState();
+}
+
+bool UZCCharacterMovementComponent::IsFollowingReplicatedClimbState() const
+{
+	return bUseReplicatedClimbState && !CVarProxyClimbingProbes.GetValueOnAnyThread() && CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy;
+}
+
+void UZCCharacterMovementComponent::PublishReplicatedClimbState()
+{
+	if (!bUseReplicatedClimbState || !CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_Authority)
+		return;
+
+	// Only replicates once, when climbing ends, since nothing changes after that
+	if (!IsClimbing())
+	{
+		ReplicatedClimbState.Clear();
+		return;
+	}
+
+	const float ContactDistance = (UpdatedComponent->GetComponentLocation() - CurrentClimbingPosition) | CurrentClimbingNormal;
+	ReplicatedClimbState.Pack(CurrentClimbingNormal, ContactDistance, IsClimbDashing(), ClimbDashDirection, bIsInLedgeClimb);
+}
+
+void UZCCharacterMovementComponent::FollowReplicatedClimbState(float DeltaTime)
+{
+	// Nothing here issues a scene query, the proxy's position and rotation already come from replicated movement
+	CurrentWallContacts.Reset();
+	if (!IsClimbing())
+	{
+		CurrentClimbingNormal = FVector::ZeroVector;
+		bIsInLedgeClimb = false;
+		bWantsToClimbDash = false;
+		ClimbDashDirection = FVector::ZeroVector;
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_ZCProxiesFollowingState);
+
+	// Climbing replicated ahead of the server's first climbing state, hold off until it arrives and snap to it then
+	if (ReplicatedClimbState.IsCleared())
+		return;
+
+	// Snaps on the first tick of a climb, smooths after that
+	const FVector TargetNormal = ReplicatedClimbState.GetSurfaceNormal();
+	const bool bSnap = CurrentClimbingNormal.IsNearlyZero();
+	CurrentClimbingNormal = bSnap ? TargetNormal : FMath::VInterpNormalRotationTo(CurrentClimbingNormal, TargetNormal, DeltaTime, ReplicatedNormalSmoothingSpeed);
+	ReplicatedContactDistance = bSnap ? ReplicatedClimbState.GetContactDistance() : FMath::FInterpTo(ReplicatedContactDistance, ReplicatedClimbState.GetContactDistance(), DeltaTime, ReplicatedDistanceSmoothingSpeed);
+	CurrentClimbingPosition = UpdatedComponent->GetComponentLocation() - CurrentClimbingNormal * ReplicatedContactDistance;
+
+	bWantsToClimbDash = ReplicatedClimbState.IsClimbDashing();
+	ClimbDashDirection = ReplicatedClimbState.GetDashDirection();
+	bIsInLedgeClimb = ReplicatedClimbState.IsLedgeClimbing();
+}
+
+void UZCCharacterMovementComponent::PublishClimbingAnimState()
+{
+	ClimbingAnimState.bIsClimbing = IsClimbing();
+	ClimbingAnimState.bIsClimbDashing = IsClimbDashing();
+	ClimbingAnimState.bIsLedgeClimbing = IsLedgeClimbing();
+	ClimbingAnimState.ClimbDashDirection = GetClimbDashDirection();
+	ClimbingAnimState.ClimbSurfaceNormal = GetClimbSurfaceNormal();
 }
 
 void UZCCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
@@ -89,9 +437,15 @@ void UZCCharacterMovementComponent::PhysCustom(float deltaTime, int32 Iterations
 
 void UZCCharacterMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
 {
+	ContactTracker.Reset();
+
 	if (IsClimbing())
 	{
 		bOrientRotationToMovement = false;
+		bForceClimbingLODRefresh = true;
+		bForceClimbingStepRefresh = true;
+		ClimbingTimeAccumulator = 0.f;
+		PreviousClimbingStepTransform = UpdatedComponent->GetComponentTransform();
 
 		// Shrink down
 		UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
@@ -114,6 +468,13 @@ void UZCCharacterMovementComponent::OnMovementModeChanged(EMovementMode Previous
 
 		// After exiting climbing mode, reset velocity and acceleration
 		StopMovementImmediately();
+
+		// So the next climb can't start out on this one's surface
+		CurrentClimbingNormal = FVector::ZeroVector;
+		CurrentClimbingPosition = FVector::ZeroVector;
+
+		// The montage may play on, but the next climb mustn't wait for it
+		bIsLedgeClimbMontagePlaying = false;
 	}
 
 	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
@@ -129,47 +490,421 @@ float UZCCharacterMovementComponent::GetMaxAcceleration() const
 	return IsClimbing() ? MaxClimbingAcceleration : Super::GetMaxAcceleration();
 }
 
-void UZCCharacterMovementComponent::SweepAndStoreWallHits()
+void UZCCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	const bool bClientWantsToClimb = (Flags & FSavedMove_ZCCharacter::FLAG_WantsToClimb) != 0;
+	const bool bClientWantsToClimbDash = (Flags & FSavedMove_ZCCharacter::FLAG_WantsToClimbDash) != 0;
+
+	// The server never takes a climb start on the client's word, ValidateClientClimbStart checks it whether a contact was claimed or not
+	if (!bClientWantsToClimb)
+	{
+		bWantsToClimb = false;
+	}
+	else if (!bWantsToClimb)
+	{
+		// Sent along by clients using packed move RPCs, which is the default
+		const FZCCharacterNetworkMoveData* MoveData = static_cast<const FZCCharacterNetworkMoveData*>(GetCurrentNetworkMoveData());
+		const bool bHasClaim = MoveData && MoveData->bHasClimbStartClaim;
+		const FZCClimbContactClaim Claim = bHasClaim ? FZCClimbContactClaim{ MoveData->ClimbStartPosition, MoveData->ClimbStartNormal } : FZCClimbContactClaim();
+
+		bWantsToClimb = CharacterOwner->GetLocalRole() == ROLE_Authority ? ValidateClientClimbStart(bHasClaim ? &Claim : nullptr) : true;
+	}
+
+	// Only react to the move the client started dashing on. The server may finish a dash a frame before the client stops sending the flag.
+	if (bClientWantsToClimbDash && !bLastClientClimbDashFlag)
+		TryClimbDashing();
+	else if (!bClientWantsToClimbDash && bWantsToClimbDash)
+		StopClimbDashing();
+
+	bLastClientClimbDashFlag = bClientWantsToClimbDash;
+}
+
+FNetworkPredictionData_Client* UZCCharacterMovementComponent::GetPredictionData_Client() const
+{
+	check(PawnOwner != nullptr);
+
+	if (!ClientPredictionData)
+	{
+		UZCCharacterMovementComponent* MutableThis = const_cast<UZCCharacterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_ZCCharacter(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UZCCharacterMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
+{
+	TEnumAsByte<EMovementMode> ServerMode;
+	TEnumAsByte<EMovementMode> ServerGroundMode;
+	uint8 ServerCustomMode = 0;
+	UnpackNetworkMovementMode(ServerMovementMode, ServerMode, ServerCustomMode, ServerGroundMode);
+
+	const bool bServerIsClimbing = ServerMode == MOVE_Custom && ServerCustomMode == CMOVE_Climbing;
+	if (IsClimbing() || bServerIsClimbing)
+	{
+		++NumClimbingCorrections;
+		INC_DWORD_STAT(STAT_ZCClimbingCorrections);
+	}
+
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
+}
+
+bool UZCCharacterMovementComponent::ValidateClientClimbStart(const FZCClimbContactClaim* Claim)
+{
+	// The baked grid answers from memory
+	bool bCanClimbFromGrid = false;
+	if (CanStartClimbingFromGrid(bCanClimbFromGrid))
+		return bCanClimbFromGrid;
+
+	if (Claim && bValidateClimbStartClaims)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ZCClimbStartClaimCheck);
+
+		// A contact the client couldn't have touched is turned down without a query
+		if (!IsClimbStartClaimPlausible(*Claim))
+		{
+			INC_DWORD_STAT(STAT_ZCClimbStartsRejected);
+			return false;
+		}
+
+		if (RecentSurfaces.Confirms(*Claim, GetWorld()->GetTimeSeconds(), ClimbClaimCacheMaxAge, ClimbClaimDistanceTolerance, ClimbClaimAngleCos))
+		{
+			INC_DWORD_STAT(STAT_ZCClimbStartsCached);
+			return true;
+		}
+
+		if (ConfirmClimbStartClaim(*Claim))
+		{
+			INC_DWORD_STAT(STAT_ZCClimbStartsRayConfirmed);
+			return true;
+		}
+
+		// The server's world may just differ a little from what the client saw, the full checks settle it
+		INC_DWORD_STAT(STAT_ZCClimbStartReprobes);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ZCClimbStartFullCheck);
+
+	// Nothing the client sent holds up, so the server runs the same checks a local climb start does, eye height trace and all
+	if (bWallHitsStale)
+	{
+		bHasProximityResult = false;
+		SweepAndStoreWallHits();
+	}
+
+	if (CanStartClimbing())
+		return true;
+
+	INC_DWORD_STAT(STAT_ZCClimbStartsRejected);
+	return false;
+}
+
+bool UZCCharacterMovementComponent::IsClimbStartClaimPlausible(const FZCClimbContactClaim& Claim) const
+{
+	if (!Claim.Normal.IsNormalized() || !IsFacingSurface(Claim.Normal))
+		return false;
+
+	// Has to be somewhere the wall sweep's capsule could have touched
+	const FVector Center = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetForwardVector() * CollisionCapsulForwardOffset;
+	const FVector SegmentOffset = FVector::UpVector * FMath::Max(0, CollisionCapsulHalfHeight - CollisionCapsulRadius);
+	return FMath::PointDistToSegment(Claim.Position, Center - SegmentOffset, Center + SegmentOffset) <= CollisionCapsulRadius + ClimbClaimDistanceTolerance;
+}
+
+bool UZCCharacterMovementComponent::ConfirmClimbStartClaim(const FZCClimbContactClaim& Claim)
+{
+	// Straight from the character at the contact. Always blocking, an async result would be for wherever the last claim was.
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector Direction = (Claim.Position - Start).GetSafeNormal();
+	const FVector End = Claim.Position + Direction * ClimbClaimDistanceTolerance;
+
+	FHitResult Hit;
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ClimbTraceChannel, ClimbQueryParams);
+	CountClimbQuery(FCollisionShape::LineShape, bHit ? 1 : 0);
+	if (!bHit)
+		return false;
+
+	if (FVector::DistSquared(Hit.ImpactPoint, Claim.Position) > FMath::Square(ClimbClaimDistanceTolerance) || (Hit.ImpactNormal | Claim.Normal) < ClimbClaimAngleCos)
+		return false;
+
+	// The climb channel passes through anything that isn't climbable, and climb proxies stand in for their meshes on it. So check
+	// the way there is clear for the character itself, stopping short of the surface so the climbed mesh doesn't count.
+	const FVector ClearEnd = Hit.ImpactPoint - Direction * ClimbClaimDistanceTolerance;
+	if (FVector::DotProduct(ClearEnd - Start, Direction) > 0.f)
+	{
+		const bool bBlocked = GetWorld()->LineTraceTestByChannel(Start, ClearEnd, UpdatedComponent->GetCollisionObjectType(), ClimbQueryParams);
+		CountClimbQuery(FCollisionShape::LineShape, bBlocked ? 1 : 0);
+		if (bBlocked)
+		{
+			INC_DWORD_STAT(STAT_ZCClimbStartClaimsBlocked);
+			return false;
+		}
+	}
+
+	RecentSurfaces.Add(Hit.ImpactPoint, Hit.ImpactNormal, Hit.GetComponent(), GetWorld()->GetTimeSeconds());
+	return true;
+}
+
+void UZCCharacterMovementComponent::CacheRecentSurfaces()
+{
+	// Only a server checking a remote client's claims needs them
+	if (!bValidateClimbStartClaims || !CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_Authority || CharacterOwner->GetRemoteRole() != ROLE_AutonomousProxy)
+		return;
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	for (const FZCClimbContact& WallContact : CurrentWallContacts)
+		RecentSurfaces.Add(WallContact.ImpactPoint, WallContact.Normal, WallContact.GetComponent(), Time);
+}
+
+void UZCCharacterMovementComponent::SweepAndStoreWallHits()
+{
+	ZC_CLIMB_STAGE_SCOPE(WallSweep);
+
+	bWallHitsStale = !ShouldSweepForWalls();
+	if (bWallHitsStale)
+	{
+		++WallSweepsSkipped;
+		INC_DWORD_STAT(STAT_ZCWallSweepsSkipped);
+		CurrentWallContacts.Reset();
+		return;
+	}
+
+	if (TrackWallContacts())
+	{
+		++WallSweepsTracked;
+		INC_DWORD_STAT(STAT_ZCContactsTracked);
+		CacheRecentSurfaces();
+		return;
+	}
+
+	// Contacts are about to change, they get tracked again from the surface info worked out from them
+	ContactTracker.Reset();
+
+	++WallSweepsRun;
+	INC_DWORD_STAT(STAT_ZCWallSweepsRun);
+
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(CollisionCapsulRadius, CollisionCapsulHalfHeight);
+
+	const FVector StartOffset = UpdatedComponent->GetForwardVector() * CollisionCapsulForwardOffset;
+
+	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;	// a bit in front
+	const FVector End = Start + UpdatedComponent->GetForwardVector();				// using the same start/end location for a sweep doesn't trigger hits on Landscapes
+
+	const bool bHitWall = ClimbQueryMulti(WallSweepHits, EZCClimbProbe::WallSweep, Start, End, CollisionShape);
+
+	if (!bHitWall)
+		CurrentWallContacts.Reset();
+	else if (const int32 NumDropped = CurrentWallContacts.Fill(WallSweepHits))
+		INC_DWORD_STAT_BY(STAT_ZCContactsDropped, NumDropped);
+
+	CacheRecentSurfaces();
+
+	LastWallSweepLocation = Start;
+	if (IsInGameThread())
+		DrawDebug(Start);
+	else
+		bPendingWallSweepDebug = true;
+}
+
+void UZCCharacterMovementComponent::RunBatchedClimbingQueries()
+{
+	// Simulated proxies following the server's state have nothing to query
+	if (IsFollowingReplicatedClimbState())
+	{
+		bForceClimbingLODRefresh = false;
+		bHasBatchedSurfaceInfo = false;
+		return;
+	}
+
+	// Same order as TickComponent then the start of the next PhysClimbing
+	if (ShouldRunClimbingLODStage(GetClimbingLODSettings().WallSweepInterval))
+		SweepAndStoreWallHits();
+	else
+		bWallHitsStale = true;
+
+	bForceClimbingLODRefresh = false;
+
+	bHasBatchedSurfaceInfo = false;
+	const uint32 NextFrame = ClimbingLODFrame + 1;
+	if (IsClimbing() && !CanReprojectSurfaceInfo() && ShouldRunClimbingLODStage(GetClimbingLODSettings().SurfaceInfoInterval, NextFrame))
+	{
+		GatherSurfaceInfo(BatchedClimbingNormal, BatchedClimbingPosition);
+		BatchedSurfaceTransform = UpdatedComponent->GetComponentTransform();
+		BatchedSurfaceFrame = NextFrame;
+		bHasBatchedSurfaceInfo = true;
+	}
+}
+
+void UZCCharacterMovementComponent::FinishBatchedClimbingQueries()
+{
+	if (bPendingWallSweepDebug)
+	{
+		bPendingWallSweepDebug = false;
+		DrawDebug(LastWallSweepLocation);
+	}
+}
+
+bool UZCCharacterMovementComponent::ShouldSweepForWalls()
+{
+	if (!bUseProximityGating || bWantsToClimb || IsClimbing())
+		return true;
+
+	// Anything the sweep could touch is within this distance of the character
+	const float SweepReach = CollisionCapsulForwardOffset + FMath::Max(CollisionCapsulRadius, CollisionCapsulHalfHeight) + 1;
+
+	// The overlap covers the sweep's reach plus a margin, so it only needs re-running once we've moved further than that margin
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	if (!bHasProximityResult || FVector::DistSquared(Location, LastProximityCheckLocation) > FMath::Square(ProximityCheckMargin))
+	{
+		const FCollisionShape ProximityShape = FCollisionShape::MakeSphere(SweepReach + ProximityCheckMargin);
+		bIsNearClimbableSurface = GetWorld()->OverlapBlockingTestByChannel(Location, FQuat::Identity, ClimbTraceChannel, ProximityShape, ClimbQueryParams);
+		++ClimbingProfile.Overlaps;
+		INC_DWORD_STAT(STAT_ZCOverlaps);
+		LastProximityCheckLocation = Location;
+		bHasProximityResult = true;
+		INC_DWORD_STAT(STAT_ZCProximityOverlaps);
+	}
+
+	return bIsNearClimbableSurface;
+}
+
+const FZCClimbingLODSettings& UZCCharacterMovementComponent::GetClimbingLODSettings() const
+{
+	static const FZCClimbingLODSettings HighLODSettings;
+
+	switch (ClimbingLOD)
+	{
+	case EZCClimbingLOD::Medium:	return MediumLODSettings;
+	case EZCClimbingLOD::Low:		return LowLODSettings;
+	default:						return HighLODSettings;
+	}
+}
+
+bool UZCCharacterMovementComponent::ShouldRunClimbingLODStage(int32 Interval) const
+{
+	return ShouldRunClimbingLODStage(Interval, ClimbingLODFrame);
+}
+
+bool UZCCharacterMovementComponent::ShouldRunClimbingLODStage(int32 Interval, uint32 Frame) const
+{
+	// Offset by the object id so characters on the same LOD spread their work across ticks instead of all probing on the same one
+	return bForceClimbingLODRefresh || Interval <= 1 || (Frame + GetUniqueID()) % Interval == 0;
+}
+
+void UZCCharacterMovementComponent::CheckClimbTickBudget(int32 TickQueries, uint64 TickCycles)
+{
+	++ClimbingProfile.ClimbTicks;
+	ClimbingProfile.PeakTickQueries = FMath::Max(ClimbingProfile.PeakTickQueries, TickQueries);
+	ClimbingProfile.PeakTickCycles = FMath::Max(ClimbingProfile.PeakTickCycles, TickCycles);
+
+	const int32 QueryBudget = CVarClimbTickQueryBudget.GetValueOnGameThread();
+	const float TimeBudget = CVarClimbTickTimeBudget.GetValueOnGameThread();
+	const double TickMicroseconds = FPlatformTime::ToMilliseconds64(TickCycles) * 1000.0;
+
+	const bool bOverQueryBudget = QueryBudget > 0 && TickQueries > QueryBudget;
+	const bool bOverTimeBudget = TimeBudget > 0.f && TickMicroseconds > TimeBudget;
+	if (!bOverQueryBudget && !bOverTimeBudget)
+		return;
+
+	// Only warn the first time per character, the count is what matters after that
+	if (!bHasWarnedAboutClimbBudget)
+	{
+		bHasWarnedAboutClimbBudget = true;
+		UE_LOG(LogZCClimbing, Warning, TEXT("%s went over its climbing tick budget: %d queries (budget %d), %.1f us (budget %.1f)"), *GetNameSafe(GetOwner()), TickQueries, QueryBudget, TickMicroseconds, TimeBudget);
+	}
+
+	++ClimbingProfile.BudgetOverruns;
+	INC_DWORD_STAT(STAT_ZCClimbBudgetOverruns);
+}
+
+bool UZCCharacterMovementComponent::CanStartClimbing() const
+{
+	bool bCanClimbFromGrid = false;
+	if (CanStartClimbingFromGrid(bCanClimbFromGrid))
+		return bCanClimbFromGrid;
+
+	for (int32 HitIndex = 0; HitIndex < CurrentWallContacts.Num(); ++HitIndex)
+		if (HorizontalClimbCheck(CurrentWallContacts[HitIndex]) && VerticalClimbCheck(CurrentWallContacts[HitIndex], HitIndex))
+			return true;
+
+	return false;
+}
+
+bool UZCCharacterMovementComponent::CanStartClimbingFromGrid(bool& bOutCanClimb) const
 {
-	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(CollisionCapsulRadius, CollisionCapsulHalfHeight);
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const AZCClimbGrid* Grid = FindClimbGrid(Location);
+	if (!Grid)
+		return false;
 
-	const FVector StartOffset = UpdatedComponent->GetForwardVector() * CollisionCapsulForwardOffset;
+	// Anything that can move isn't part of the bake so it has to go through the live checks
+	if (!AreWallHitsStatic())
+		return false;
 
-	const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;	// a bit in front
-	const FVector End = Start + UpdatedComponent->GetForwardVector();				// using the same start/end location for a sweep doesn't trigger hits on Landscapes
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+	const float Step = Grid->GetCellSize();
+	const float Reach = CollisionCapsulForwardOffset + CollisionCapsulRadius;
 
-	TArray<FHitResult> Hits;
-	check(GetWorld());
-	const bool bHitWall = GetWorld()->SweepMultiByChannel(Hits, Start, End, FQuat::Identity, ECC_WorldStatic, CollisionShape, ClimbQueryParams);
+	// Covers the same space as the wall sweep: in front of the character from the bottom to the top of the capsule
+	bool bIsFacingClimbableSurface = false;
+	for (float Height = -CollisionCapsulHalfHeight; Height <= CollisionCapsulHalfHeight && !bIsFacingClimbableSurface; Height += Step)
+		for (float Distance = 0; Distance <= Reach + Step && !bIsFacingClimbableSurface; Distance += Step)
+		{
+			const FZCClimbGridCell* Cell = Grid->FindCell(Location + (Forward * Distance) + (FVector::UpVector * Height));
+			bIsFacingClimbableSurface = Cell && Cell->IsClimbable() && IsFacingSurface(Cell->GetNormal());
+		}
 
-	bHitWall ? CurrentWallHits = Hits : CurrentWallHits.Reset();
+	// Equivalent of the eye height trace, there just has to be some surface in front of the eyes
+	bool bIsHighEnough = false;
+	const FVector EyeHeight = GetEyeHeightLocation();
+	for (float Distance = 0; Distance <= Reach + Step && !bIsHighEnough; Distance += Step)
+		bIsHighEnough = Grid->FindCell(EyeHeight + (Forward * Distance)) != nullptr;
 
-	DrawDebug(Start);
+	bOutCanClimb = bIsFacingClimbableSurface && bIsHighEnough;
+	return true;
 }
 
-bool UZCCharacterMovementComponent::CanStartClimbing() const
+const AZCClimbGrid* UZCCharacterMovementComponent::FindClimbGrid(const FVector& Location) const
 {
-	for (const FHitResult& WallHit : CurrentWallHits)
-		if (HorizontalClimbCheck(WallHit) && VerticalClimbCheck(WallHit))
-			return true;
+	for (const AZCClimbGrid* Grid : ClimbGrids)
+		if (IsValid(Grid) && Grid->Covers(Location))
+			return Grid;
 
-	return false;
+	return nullptr;
 }
 
-bool UZCCharacterMovementComponent::HorizontalClimbCheck(const FHitResult& WallHit) const
+bool UZCCharacterMovementComponent::AreWallHitsStatic() const
 {
-	const FVector WallHorizontalNormal = WallHit.Normal.GetSafeNormal2D();
+	for (const FZCClimbContact& WallContact : CurrentWallContacts)
+	{
+		const UPrimitiveComponent* HitComponent = WallContact.GetComponent();
+		if (HitComponent && HitComponent->Mobility != EComponentMobility::Static)
+			return false;
+	}
+
+	return true;
+}
+
+bool UZCCharacterMovementComponent::HorizontalClimbCheck(const FZCClimbContact& WallContact) const
+{
+	return IsFacingSurface(WallContact.Normal);
+}
+
+bool UZCCharacterMovementComponent::IsFacingSurface(const FVector& SurfaceNormal) const
+{
+	const FVector WallHorizontalNormal = SurfaceNormal.GetSafeNormal2D();
 	const FVector PlayerForward = UpdatedComponent->GetForwardVector();
 	const float LookAngleCos = PlayerForward.Dot(-WallHorizontalNormal);// inverse wall normal so the vectors are pointing the "same" direction
-	const float LookAngleDiff = FMath::RadiansToDegrees(FMath::Acos(LookAngleCos));
-	
-	return LookAngleDiff <= MinHorizontalDegreesToStartClimbing;
+
+	// Comparing against the cached cosine of the max angle is the same as comparing angles, without the Acos
+	return LookAngleCos >= MinHorizontalClimbAngleCos;
 }
 
-bool UZCCharacterMovementComponent::VerticalClimbCheck(const FHitResult& WallHit) const
+bool UZCCharacterMovementComponent::VerticalClimbCheck(const FZCClimbContact& WallContact, int32 HitIndex) const
 {
-	const FVector WallHorizontalNormal = WallHit.Normal.GetSafeNormal2D();
-	const float VerticalAngleCos = FVector::DotProduct(WallHit.Normal, WallHorizontalNormal);
+	const FVector WallHorizontalNormal = WallContact.Normal.GetSafeNormal2D();
+	const float VerticalAngleCos = FVector::DotProduct(WallContact.Normal, WallHorizontalNormal);
 
 	// Check if the surface is too flat
 	const bool bIsCeilingOrFloor = FMath::IsNearlyZero(VerticalAngleCos);
@@ -178,7 +913,7 @@ bool UZCCharacterMovementComponent::VerticalClimbCheck(const FHitResult& WallHit
 	const float CollisionEdge = CollisionCapsulRadius + CollisionCapsulForwardOffset;
 	const float SteepnessMultiplier = 1 + (1 - VerticalAngleCos) * 6; // magic number here extends it _just_ a bit further so it works on all the angles we need.
 	const float TraceLength = CollisionEdge * SteepnessMultiplier;
-	const bool bIsHighEnough = EyeHeightTrace(TraceLength);
+	const bool bIsHighEnough = EyeHeightTrace(TraceLength, EZCClimbProbe::ClimbStartEyeHeight, HitIndex);
 
 
 	// TODO: minimum steepness requirement otherwise its possible to allow climbing on a very long, not so steep surface that we can otherwise walk up if it _just_ hits the bottom of the collider
@@ -187,20 +922,25 @@ bool UZCCharacterMovementComponent::VerticalClimbCheck(const FHitResult& WallHit
 	return bIsHighEnough && !bIsCeilingOrFloor;
 }
 
-bool UZCCharacterMovementComponent::EyeHeightTrace(const float TraceDistance) const
+bool UZCCharacterMovementComponent::EyeHeightTrace(const float TraceDistance, EZCClimbProbe Probe, int32 ProbeIndex) const
 {
 	FHitResult UpperEdgeHit;
 
-	const ACharacter* Owner = GetCharacterOwner();
-	const float BaseEyeHeight = Owner ? Owner->BaseEyeHeight + 30 : 1;
-	const float EyeHeightOffset = IsClimbing() ? BaseEyeHeight + CollisionCapsulClimbingShinkAmount : BaseEyeHeight;
-
-	const FVector EyeHeight = UpdatedComponent->GetComponentLocation() + (UpdatedComponent->GetUpVector() * EyeHeightOffset);
+	const FVector EyeHeight = GetEyeHeightLocation();
 	const FVector End = EyeHeight + (UpdatedComponent->GetForwardVector() * TraceDistance);
 
 	DrawEyeTraceDebug(EyeHeight, End);
 
-	return GetWorld()->LineTraceSingleByChannel(UpperEdgeHit, EyeHeight, End, ECC_WorldStatic, ClimbQueryParams);
+	return ClimbQuerySingle(UpperEdgeHit, Probe, ProbeIndex, EyeHeight, End);
+}
+
+FVector UZCCharacterMovementComponent::GetEyeHeightLocation() const
+{
+	const ACharacter* Owner = GetCharacterOwner();
+	const float BaseEyeHeight = Owner ? Owner->BaseEyeHeight + 30 : 1;
+	const float EyeHeightOffset = IsClimbing() ? BaseEyeHeight + CollisionCapsulClimbingShinkAmount : BaseEyeHeight;
+
+	return UpdatedComponent->GetComponentLocation() + (UpdatedComponent->GetUpVector() * EyeHeightOffset);
 }
 
 void UZCCharacterMovementComponent::PhysClimbing(float DeltaTime, int32 Iterations)
@@ -209,15 +949,49 @@ void UZCCharacterMovementComponent::PhysClimbing(float DeltaTime, int32 Iteratio
 	if (DeltaTime < MIN_TICK_TIME)
 		return;
 
-	ComputeSurfaceInfo();
+	ZC_CLIMB_STAGE_SCOPE(PhysClimbing);
+
+	if (!bUseFixedClimbingTimestep)
+	{
+		ClimbingSubstep(DeltaTime, Iterations);
+		return;
+	}
+
+	const float StepTime = 1.f / FixedClimbingRate;
+	ClimbingTimeAccumulator = FMath::Min(ClimbingTimeAccumulator + DeltaTime, StepTime * MaxClimbingSubsteps);
+
+	while (ClimbingTimeAccumulator >= StepTime)
+	{
+		ClimbingTimeAccumulator -= StepTime;
+		PreviousClimbingStepTransform = UpdatedComponent->GetComponentTransform();
+
+		if (!ClimbingSubstep(StepTime, Iterations))
+		{
+			ClimbingTimeAccumulator = 0.f;
+			return;
+		}
+	}
+}
+
+bool UZCCharacterMovementComponent::ClimbingSubstep(float DeltaTime, int32 Iterations)
+{
+	// Lower LODs keep climbing on the last surface info between updates, except on the first step after starting to climb or changing LOD
+	const FZCClimbingLODSettings& LODSettings = GetClimbingLODSettings();
+	const bool bForceRefresh = bForceClimbingStepRefresh;
+	bForceClimbingStepRefresh = false;
+
+	if (bForceRefresh || ShouldRunClimbingLODStage(LODSettings.SurfaceInfoInterval))
+		ComputeSurfaceInfo();
 
-	if (ShouldStopClimbing() || ClimbDownToFloor())
+	const bool bCheckLedgeAndFloor = bForceRefresh || ShouldRunClimbingLODStage(LODSettings.LedgeAndFloorCheckInterval);
+
+	if (ShouldStopClimbing() || (bCheckLedgeAndFloor && ClimbDownToFloor()))
 	{
 		// Don't exit climbing if the montage is done otherwise the capsule returns to full height and regular physics takes over too early resulting in falling off the ledge
-		if (AnimInstance && !AnimInstance->Montage_IsPlaying(LedgeClimbMontage))
+		if (!bIsLedgeClimbMontagePlaying)
 		{
 			StopClimbing(DeltaTime, Iterations);
-			return;
+			return false;
 		}
 	}
 
@@ -227,43 +1001,189 @@ void UZCCharacterMovementComponent::PhysClimbing(float DeltaTime, int32 Iteratio
 	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
 
 	MoveAlongClimbingSurface(DeltaTime);
-	TryClimbUpLedge();
+	if (bCheckLedgeAndFloor)
+		TryClimbUpLedge();
 
 	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
 		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
 
 	SnapToClimbingSurface(DeltaTime);
+	return true;
+}
+
+void UZCCharacterMovementComponent::UpdateClimbingMeshInterpolation()
+{
+	USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+	const bool bShouldInterpolate = Mesh && IsClimbing() && bUseFixedClimbingTimestep && bInterpolateClimbingMesh
+		&& CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy;	// simulated proxies already have network smoothing on the mesh
+
+	if (!bShouldInterpolate)
+	{
+		ResetClimbingMeshInterpolation();
+		return;
+	}
+
+	// Render between the last two steps by how far we are into the next one
+	const float Alpha = FMath::Clamp(ClimbingTimeAccumulator * FixedClimbingRate, 0.f, 1.f);
+	const FTransform& Current = UpdatedComponent->GetComponentTransform();
+	const FVector Location = FMath::Lerp(PreviousClimbingStepTransform.GetLocation(), Current.GetLocation(), Alpha);
+	const FQuat Rotation = FQuat::Slerp(PreviousClimbingStepTransform.GetRotation(), Current.GetRotation(), Alpha);
+
+	Mesh->SetWorldLocationAndRotation(Location + Rotation.RotateVector(CharacterOwner->GetBaseTranslationOffset()), Rotation * CharacterOwner->GetBaseRotationOffset());
+	bClimbingMeshInterpolated = true;
+}
+
+void UZCCharacterMovementComponent::ResetClimbingMeshInterpolation()
+{
+	if (!bClimbingMeshInterpolated)
+		return;
+
+	bClimbingMeshInterpolated = false;
+	if (USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr)
+		Mesh->SetRelativeLocationAndRotation(CharacterOwner->GetBaseTranslationOffset(), CharacterOwner->GetBaseRotationOffset());
 }
 
 void UZCCharacterMovementComponent::ComputeSurfaceInfo()
 {
-	CurrentClimbingNormal = FVector::ZeroVector;
-	CurrentClimbingPosition = FVector::ZeroVector;
+	if (ReprojectSurfaceInfo())
+		return;
+
+	if (!ConsumeBatchedSurfaceInfo())
+		GatherSurfaceInfo(CurrentClimbingNormal, CurrentClimbingPosition);
+
+	if (bUseIncrementalContactTracking)
+		ContactTracker.Capture(CurrentWallContacts, CurrentClimbingNormal, CurrentClimbingPosition, UpdatedComponent->GetComponentTransform(), ContactReprobeAngleCos);
+}
+
+bool UZCCharacterMovementComponent::CanReprojectSurfaceInfo() const
+{
+	return bUseIncrementalContactTracking && !bForceClimbingLODRefresh && ContactTracker.IsTracking()
+		&& !ContactTracker.NeedsReprobe(UpdatedComponent->GetComponentTransform(), ContactReprobeDistance, ContactReprobeAngleCos);
+}
+
+bool UZCCharacterMovementComponent::ReprojectSurfaceInfo()
+{
+	ZC_CLIMB_STAGE_SCOPE(SurfaceInfo);
+
+	return CanReprojectSurfaceInfo() && ContactTracker.ReprojectSurface(UpdatedComponent->GetComponentTransform(), CurrentClimbingNormal, CurrentClimbingPosition);
+}
+
+bool UZCCharacterMovementComponent::TrackWallContacts()
+{
+	if (!IsClimbing() || !CanReprojectSurfaceInfo())
+		return false;
+
+	const FTransform& Transform = UpdatedComponent->GetComponentTransform();
+	FVector Normal;
+	FVector Position;
+	if (!ContactTracker.ReprojectSurface(Transform, Normal, Position))
+		return false;
+
+	// One ray straight at the wall to check it's still where the tracked contacts say it is
+	const FVector Start = Transform.GetLocation();
+	const float ExpectedDistance = (Start - Position) | Normal;
+	const FVector End = Start - Normal * (ExpectedDistance + ContactValidationTolerance * 2.f);
+
+	FHitResult ValidationHit;
+	ClimbQuerySingle(ValidationHit, EZCClimbProbe::ContactValidation, 0, Start, End);
+
+	if (!ContactTracker.Agrees(ValidationHit, Normal, ExpectedDistance, ContactValidationTolerance, ContactReprobeAngleCos))
+	{
+		INC_DWORD_STAT(STAT_ZCContactReprobes);
+		return false;
+	}
+
+	return ContactTracker.ReprojectContacts(Transform, CurrentWallContacts);
+}
+
+bool UZCCharacterMovementComponent::ConsumeBatchedSurfaceInfo()
+{
+	if (!bHasBatchedSurfaceInfo)
+		return false;
+
+	// Only good for the update it was gathered for, and only if nothing has moved the character since
+	bHasBatchedSurfaceInfo = false;
+	if (BatchedSurfaceFrame != ClimbingLODFrame || !BatchedSurfaceTransform.Equals(UpdatedComponent->GetComponentTransform(), 0.f))
+		return false;
+
+	CurrentClimbingNormal = BatchedClimbingNormal;
+	CurrentClimbingPosition = BatchedClimbingPosition;
+	return true;
+}
+
+void UZCCharacterMovementComponent::GatherSurfaceInfo(FVector& OutNormal, FVector& OutPosition) const
+{
+	ZC_CLIMB_STAGE_SCOPE(SurfaceInfo);
+
+	OutNormal = FVector::ZeroVector;
+	OutPosition = FVector::ZeroVector;
 
-	if (CurrentWallHits.IsEmpty())
+	if (CurrentWallContacts.IsEmpty())
 		return;
 
+	TArray<FZCSurfaceSample, TInlineAllocator<8>> Samples;
+	GatherSurfaceSamples(Samples);
+
 	const FVector Start = UpdatedComponent->GetComponentLocation();
 	const FCollisionShape CollisionShape = FCollisionShape::MakeSphere(6);//TODO: magic number just for a reasonably smol sphere
 
-	for (const FHitResult& WallHit : CurrentWallHits)
+	// All the probes are issued back to back so in async mode they go out to the physics scene as one batch
+	int32 TotalWeight = 0;
+	for (int32 SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
 	{
+		const FZCSurfaceSample& Sample = Samples[SampleIndex];
+
 		// Using an additional raycast from the character to the point of impact makes sure if the sweep was _under_ or _inside_ geometry we only take the normal of the first face we encounter
-		const FVector End = Start + (WallHit.ImpactPoint - Start).GetSafeNormal() * 120; //TODO: magic number here is just making sure we make it to the surface
+		const FVector End = Start + (Sample.ImpactPoint - Start).GetSafeNormal() * 120; //TODO: magic number here is just making sure we make it to the surface
 		FHitResult AssistHit;
-		GetWorld()->SweepSingleByChannel(AssistHit, Start, End, FQuat::Identity, ECC_WorldStatic, CollisionShape, ClimbQueryParams);
+		ClimbQuerySingle(AssistHit, EZCClimbProbe::SurfaceAssist, SampleIndex, Start, End, CollisionShape);
 
-		CurrentClimbingPosition += AssistHit.ImpactPoint;
-		CurrentClimbingNormal += AssistHit.Normal;
+		// Weighted by how many wall hits were merged so the average comes out the same as probing every hit
+		OutPosition += AssistHit.ImpactPoint * Sample.Weight;
+		OutNormal += AssistHit.Normal * Sample.Weight;
+		TotalWeight += Sample.Weight;
 	}
 
+	INC_DWORD_STAT_BY(STAT_ZCSurfaceAssistProbes, Samples.Num());
+	INC_DWORD_STAT_BY(STAT_ZCSurfaceProbesSaved, CurrentWallContacts.Num() - Samples.Num());
+
 	// Store position as the mean of all the surface impacts
-	CurrentClimbingPosition /= CurrentWallHits.Num();
-	CurrentClimbingNormal = CurrentClimbingNormal.GetSafeNormal();
+	OutPosition /= TotalWeight;
+	OutNormal = OutNormal.GetSafeNormal();
+}
+
+void UZCCharacterMovementComponent::GatherSurfaceSamples(TArray<FZCSurfaceSample, TInlineAllocator<8>>& OutSamples) const
+{
+	for (const FZCClimbContact& WallContact : CurrentWallContacts)
+	{
+		// Face index is only filled in for complex collision so the normal is what tells apart faces of simple shapes
+		const FIntVector HitNormal(FMath::RoundToInt(WallContact.Normal.X * 100), FMath::RoundToInt(WallContact.Normal.Y * 100), FMath::RoundToInt(WallContact.Normal.Z * 100));
+
+		FZCSurfaceSample* Sample = OutSamples.FindByPredicate([&](const FZCSurfaceSample& Existing) { return Existing.IsSameFace(WallContact, HitNormal); });
+		if (!Sample)
+		{
+			Sample = &OutSamples.AddDefaulted_GetRef();
+			Sample->Component = WallContact.GetComponent();
+			Sample->FaceIndex = WallContact.FaceIndex;
+			Sample->QuantizedNormal = HitNormal;
+		}
+
+		// Running mean of the merged impact points
+		++Sample->Weight;
+		Sample->ImpactPoint += (WallContact.ImpactPoint - Sample->ImpactPoint) / Sample->Weight;
+	}
+
+	if (OutSamples.Num() > MaxSurfaceSamplesPerTick)
+	{
+		OutSamples.Sort([](const FZCSurfaceSample& A, const FZCSurfaceSample& B) { return A.Weight > B.Weight; });
+		OutSamples.SetNum(MaxSurfaceSamplesPerTick);
+	}
 }
 
 void UZCCharacterMovementComponent::ComputeClimbingVelocity(float DeltaTime)
 {
+	ZC_CLIMB_STAGE_SCOPE(Velocity);
+
 	// Note: Taken from UCharacterMovementComponent::PhysFlying
 	RestorePreAdditiveRootMotionVelocity();
 
@@ -273,8 +1193,7 @@ void UZCCharacterMovementComponent::ComputeClimbingVelocity(float DeltaTime)
 		{
 			AlignClimbDashDirection();
 
-			const float CurrentCurveSpeed = ClimbDashCurve->GetFloatValue(CurrentClimbDashTime);
-			Velocity = ClimbDashDirection * CurrentCurveSpeed;
+			Velocity = ClimbDashDirection * GetClimbDashSpeed();
 		}
 		else
 		{
@@ -305,6 +1224,8 @@ void UZCCharacterMovementComponent::StopClimbing(float DeltaTime, int32 Iteratio
 
 void UZCCharacterMovementComponent::MoveAlongClimbingSurface(float DeltaTime)
 {
+	ZC_CLIMB_STAGE_SCOPE(MoveAlongSurface);
+
 	// Note: Taken from UCharacterMovementComponent::PhysFlying
 	const FVector Adjusted = Velocity * DeltaTime;
 
@@ -327,13 +1248,16 @@ FQuat UZCCharacterMovementComponent::GetSmoothClimbingRotation(float DeltaTime)
 		return Current;
 
 	const FQuat Target = FRotationMatrix::MakeFromX(-CurrentClimbingNormal).ToQuat();
-	const float RotationSpeed = ClimbingRotationSpeed * FMath::Max(1, Velocity.Length() / MaxClimbingSpeed);// TODO: investigate an alternate way to do this
+	if (!GetClimbingLODSettings().bSmoothRotation)
+		return Target;
 
-	return FMath::QInterpTo(Current, Target, DeltaTime, RotationSpeed);
+	return FMath::QInterpTo(Current, Target, DeltaTime, GetClimbingRotationSpeed());
 }
 
 void UZCCharacterMovementComponent::SnapToClimbingSurface(float DeltaTime) const
 {
+	ZC_CLIMB_STAGE_SCOPE(SnapToSurface);
+
 	// TODO: Maybe change to a threshold later on.
 	// If within the threshold move smoothly
 	// If not we can teleport instantly to the correct distance decreasing the change the character loses grip at high velocities
@@ -345,8 +1269,7 @@ void UZCCharacterMovementComponent::SnapToClimbingSurface(float DeltaTime) const
 	const FVector Offset = -CurrentClimbingNormal * (ForwardDifference.Length() - ClimbingDistanceFromSurface);
 
 	const bool bSweep = true;
-	const float SnapSpeed = ClimbingSnapSpeed * FMath::Max(1, Velocity.Length() / MaxClimbingSpeed);
-	UpdatedComponent->MoveComponent(Offset * SnapSpeed * DeltaTime, Rotation, bSweep);
+	UpdatedComponent->MoveComponent(Offset * GetClimbingSnapSpeed() * DeltaTime, Rotation, bSweep);
 }
 
 void UZCCharacterMovementComponent::CacheClimbDashDirection()
@@ -363,16 +1286,45 @@ void UZCCharacterMovementComponent::UpdateClimbDashState(float DeltaTime)
 	if (!bWantsToClimbDash)
 		return;
 
-	CurrentClimbDashTime += DeltaTime;
+	// Acceleration is only the move's own once the move is being performed. On the server the dash flag is read before that,
+	// so picking the direction here makes the client, the server and replayed moves all use the same move's acceleration.
+	if (CurrentClimbDashTime == 0.f)
+		CacheClimbDashDirection();
 
-	// TODO: Better to cache it when dash starts
-	float MinTime, MaxTime;
-	ClimbDashCurve->GetTimeRange(MinTime, MaxTime);
+	CurrentClimbDashTime += DeltaTime;
 
-	if (CurrentClimbDashTime >= MaxTime)
+	if (CurrentClimbDashTime >= ClimbDashEndTime)
 		StopClimbDashing();
 }
 
+bool UZCCharacterMovementComponent::CanClimbDash() const
+{
+	return ClimbMotionProfile ? ClimbMotionProfile->HasDash() : ClimbDashCurve != nullptr;
+}
+
+float UZCCharacterMovementComponent::GetClimbDashSpeed() const
+{
+	return ClimbMotionProfile ? ClimbMotionProfile->GetDashSpeed(CurrentClimbDashTime) : ClimbDashCurve->GetFloatValue(CurrentClimbDashTime);
+}
+
+float UZCCharacterMovementComponent::GetClimbingRotationSpeed() const
+{
+	const float SpeedRatio = Velocity.Length() / MaxClimbingSpeed;
+	if (ClimbMotionProfile && ClimbMotionProfile->HasRotationSpeed())
+		return ClimbMotionProfile->GetRotationSpeed(SpeedRatio);
+
+	return ClimbingRotationSpeed * FMath::Max(1, SpeedRatio);// TODO: investigate an alternate way to do this
+}
+
+float UZCCharacterMovementComponent::GetClimbingSnapSpeed() const
+{
+	const float SpeedRatio = Velocity.Length() / MaxClimbingSpeed;
+	if (ClimbMotionProfile && ClimbMotionProfile->HasSnapSpeed())
+		return ClimbMotionProfile->GetSnapSpeed(SpeedRatio);
+
+	return ClimbingSnapSpeed * FMath::Max(1, SpeedRatio);
+}
+
 void UZCCharacterMovementComponent::AlignClimbDashDirection()
 {
 	const FVector HorizontalSurfaceNormal = GetClimbSurfaceNormal().GetSafeNormal2D();// gets the X and Y of the surface we're essentially prone against so up/down left/right
@@ -387,6 +1339,8 @@ void UZCCharacterMovementComponent::StopClimbDashing()
 
 bool UZCCharacterMovementComponent::ClimbDownToFloor() const
 {
+	ZC_CLIMB_STAGE_SCOPE(FloorCheck);
+
 	FHitResult FloorHit;
 	if (!CheckFloor(FloorHit))
 		return false;
@@ -411,28 +1365,42 @@ bool UZCCharacterMovementComponent::ClimbDownToFloor() const
 bool UZCCharacterMovementComponent::CheckFloor(FHitResult& OutFloorHit) const
 {
 	const FVector Start = UpdatedComponent->GetComponentLocation();
-	const FVector End = Start + FVector::DownVector * FloorCheckDistance;
+
+	// While the contacts are tracked, the floor found since they were captured still answers. Look further down than needed so it can.
+	const bool bIsTracking = CanReprojectSurfaceInfo();
+	bool bFoundTrackedFloor = false;
+	if (bIsTracking && ContactTracker.FindFloor(Start, FloorCheckDistance, OutFloorHit, bFoundTrackedFloor))
+		return bFoundTrackedFloor;
+
+	const FVector End = Start + FVector::DownVector * (FloorCheckDistance + (bIsTracking ? ContactReprobeDistance : 0.f));
 
 	DrawClimbDownDebug(Start, End);
 
-	return GetWorld()->LineTraceSingleByChannel(OutFloorHit, Start, End, ECC_WorldStatic, ClimbQueryParams);
+	const bool bHit = ClimbQuerySingle(OutFloorHit, EZCClimbProbe::Floor, 0, Start, End);
+	if (bIsTracking)
+		ContactTracker.KeepFloor(OutFloorHit, End);
+
+	return bHit && OutFloorHit.Distance <= FloorCheckDistance;
 }
 
 bool UZCCharacterMovementComponent::TryClimbUpLedge()
 {
+	ZC_CLIMB_STAGE_SCOPE(LedgeClimb);
+
 	if (!AnimInstance || !LedgeClimbMontage)
 		return false;
-	if (AnimInstance->Montage_IsPlaying(LedgeClimbMontage))
+	if (bIsLedgeClimbMontagePlaying)
 		return false;
 
 	const float UpSpeed = FVector::DotProduct(Velocity.GetSafeNormal(), UpdatedComponent->GetUpVector());
 	const bool bIsMovingUp = UpSpeed > 0;
 
-	if (bIsMovingUp && HasReachedLedge() && CanMoveToLedgeClimbLocation())
+	if (bIsMovingUp && CanClimbUpLedge())
 	{
 		const FRotator StandRotation = FRotator(0, UpdatedComponent->GetComponentRotation().Yaw, 0);
 		UpdatedComponent->SetRelativeRotation(StandRotation);
-		AnimInstance->Montage_Play(LedgeClimbMontage);
+		if (AnimInstance->Montage_Play(LedgeClimbMontage) > 0.f)
+			bIsLedgeClimbMontagePlaying = true;
 		bIsInLedgeClimb = true;
 
 		return true;
@@ -441,12 +1409,106 @@ bool UZCCharacterMovementComponent::TryClimbUpLedge()
 	return false;
 }
 
+void UZCCharacterMovementComponent::BindAnimInstance()
+{
+	if (AnimInstance)
+	{
+		AnimInstance->OnMontageBlendingOut.RemoveDynamic(this, &UZCCharacterMovementComponent::OnLedgeClimbMontageBlendingOut);
+		AnimInstance->OnMontageEnded.RemoveDynamic(this, &UZCCharacterMovementComponent::OnLedgeClimbMontageEnded);
+	}
+
+	const USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+	AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+
+	// Whatever was playing went with the old initialization, and its delegates won't fire any more
+	bIsLedgeClimbMontagePlaying = false;
+
+	if (AnimInstance)
+	{
+		// Blending out is when Montage_IsPlaying would start returning false
+		AnimInstance->OnMontageBlendingOut.AddUniqueDynamic(this, &UZCCharacterMovementComponent::OnLedgeClimbMontageBlendingOut);
+		AnimInstance->OnMontageEnded.AddUniqueDynamic(this, &UZCCharacterMovementComponent::OnLedgeClimbMontageEnded);
+	}
+}
+
+void UZCCharacterMovementComponent::OnLedgeClimbMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted)
+{
+	if (Montage == LedgeClimbMontage)
+		bIsLedgeClimbMontagePlaying = false;
+}
+
+void UZCCharacterMovementComponent::OnLedgeClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	if (Montage == LedgeClimbMontage)
+		bIsLedgeClimbMontagePlaying = false;
+}
+
+bool UZCCharacterMovementComponent::CanClimbUpLedge() const
+{
+	bool bCanClimbUpFromGraph = false;
+	if (CanClimbUpLedgeFromGraph(bCanClimbUpFromGraph))
+		return bCanClimbUpFromGraph;
+
+	return HasReachedLedge() && CanMoveToLedgeClimbLocation();
+}
+
+bool UZCCharacterMovementComponent::CanClimbUpLedgeFromGraph(bool& bOutCanClimbUp) const
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const AZCLedgeGraph* LedgeGraph = FindLedgeGraph(Location);
+	if (!LedgeGraph || !AreWallHitsStatic())
+		return false;
+
+	// Same reach as the eye height trace. The ledge has been reached once its top is below the eyes.
+	const FVector EyeHeight = GetEyeHeightLocation();
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+	const float Reach = CollisionCapsulRadius + CollisionCapsulForwardOffset;
+	if (!LedgeGraph->Covers(EyeHeight + Forward * Reach))
+		return false;
+
+	// Mid wall there's no ledge in reach and this answers no without a query. Only a graph baked too coarse to be sure hands that to the live checks.
+	const FZCLedgePoint* Ledge = LedgeGraph->FindLedge(EyeHeight, Forward, Reach, Location.Z, EyeHeight.Z, MinHorizontalClimbAngleCos);
+	if (!Ledge && !LedgeGraph->CanRuleOutLedges())
+		return false;
+
+	bOutCanClimbUp = Ledge && Ledge->bCanStand;
+	return true;
+}
+
+const AZCLedgeGraph* UZCCharacterMovementComponent::FindLedgeGraph(const FVector& Location) const
+{
+	for (const AZCLedgeGraph* LedgeGraph : LedgeGraphs)
+		if (IsValid(LedgeGraph) && LedgeGraph->Covers(Location))
+			return LedgeGraph;
+
+	return nullptr;
+}
+
 bool UZCCharacterMovementComponent::HasReachedLedge() const
 {
 	//const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
 	const float TraceDistance = CollisionCapsulRadius + CollisionCapsulForwardOffset;
+
+	// While the contacts are tracked, one hit from higher up the wall answers until the eyes climb up past where it came from
+	if (CanReprojectSurfaceInfo())
+	{
+		const FVector EyeHeight = GetEyeHeightLocation();
+		const FVector Up = UpdatedComponent->GetUpVector();
+		if (ContactTracker.IsWallAboveEyes(EyeHeight, Up))
+			return false;
+
+		if (!ContactTracker.HasEyeHeightCheck())
+		{
+			const FVector RaisedEyeHeight = EyeHeight + Up * ContactReprobeDistance;
+			FHitResult RaisedHit;
+			const bool bHitRaised = ClimbQuerySingle(RaisedHit, EZCClimbProbe::LedgeEyeHeight, 1, RaisedEyeHeight, RaisedEyeHeight + UpdatedComponent->GetForwardVector() * TraceDistance);
+			ContactTracker.KeepEyeHeightCheck(bHitRaised, RaisedEyeHeight);
+			if (bHitRaised)
+				return false;
+		}
+	}
 	
-	return !EyeHeightTrace(TraceDistance);
+	return !EyeHeightTrace(TraceDistance, EZCClimbProbe::LedgeEyeHeight);
 }
 
 bool UZCCharacterMovementComponent::IsLedgeWalkable(const FVector& LocationToCheck) const
@@ -454,7 +1516,7 @@ bool UZCCharacterMovementComponent::IsLedgeWalkable(const FVector& LocationToChe
 	const FVector CheckEnd = LocationToCheck + (FVector::DownVector * 250.f);
 
 	FHitResult LedgeHit;
-	const bool bHitLedgeGround = GetWorld()->LineTraceSingleByChannel(LedgeHit, LocationToCheck, CheckEnd, ECC_WorldStatic, ClimbQueryParams);
+	const bool bHitLedgeGround = ClimbQuerySingle(LedgeHit, EZCClimbProbe::LedgeWalkable, 0, LocationToCheck, CheckEnd);
 
 	return bHitLedgeGround && LedgeHit.Normal.Z >= GetWalkableFloorZ();
 }
@@ -474,12 +1536,194 @@ bool UZCCharacterMovementComponent::CanMoveToLedgeClimbLocation() const
 	const FVector CapsulStartCheck = LocationToCheck - HorizontalOffset;
 	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
 
-	const bool bBlocked = GetWorld()->SweepSingleByChannel(CapsulHit, CapsulStartCheck, LocationToCheck, FQuat::Identity, ECC_WorldStatic, Capsule->GetCollisionShape(), ClimbQueryParams);
+	const bool bBlocked = ClimbQuerySingle(CapsulHit, EZCClimbProbe::LedgeClearance, 0, CapsulStartCheck, LocationToCheck, Capsule->GetCollisionShape());
 	
 	//DrawDebugCapsule(GetWorld(), LocationToCheck, Capsule->GetCollisionShape().GetCapsuleHalfHeight(), Capsule->GetCollisionShape().GetCapsuleRadius(), FQuat::Identity, bBlocked ? FColor::Red : FColor::Green);
 	return !bBlocked;
 }
 
+bool UZCCharacterMovementComponent::ClimbQueryMulti(TArray<FHitResult>& OutHits, EZCClimbProbe Probe, const FVector& Start, const FVector& End, const FCollisionShape& Shape) const
+{
+	OutHits.Reset();
+
+	if (UsesAsyncClimbQueries())
+		if (const TArray<FHitResult>* AsyncHits = ConsumeAsyncClimbQuery(Probe, 0, true, Start, End, Shape))
+		{
+			OutHits.Append(*AsyncHits);
+			return FHitResult::GetFirstBlockingHit(OutHits) != nullptr;
+		}
+
+	check(GetWorld());
+	const bool bHit = GetWorld()->SweepMultiByChannel(OutHits, Start, End, FQuat::Identity, GetClimbQueryChannel(Probe), Shape, ClimbQueryParams);
+	CountClimbQuery(Shape, OutHits.Num());
+
+	return bHit;
+}
+
+bool UZCCharacterMovementComponent::ClimbQuerySingle(FHitResult& OutHit, EZCClimbProbe Probe, int32 ProbeIndex, const FVector& Start, const FVector& End, const FCollisionShape& Shape) const
+{
+	if (UsesAsyncClimbQueries())
+		if (const TArray<FHitResult>* AsyncHits = ConsumeAsyncClimbQuery(Probe, ProbeIndex, false, Start, End, Shape))
+		{
+			OutHit = AsyncHits->Num() > 0 ? (*AsyncHits)[0] : FHitResult(1.f);
+			return OutHit.bBlockingHit;
+		}
+
+	const ECollisionChannel Channel = GetClimbQueryChannel(Probe);
+	if (bCacheClimbQueriesPerTick && FindCachedClimbQuery(OutHit, Start, End, Shape, Channel))
+		return OutHit.bBlockingHit;
+
+	check(GetWorld());
+	const bool bHit = Shape.IsLine()
+		? GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, Channel, ClimbQueryParams)
+		: GetWorld()->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, Channel, Shape, ClimbQueryParams);
+	CountClimbQuery(Shape, bHit ? 1 : 0);
+
+	if (bCacheClimbQueriesPerTick)
+		CacheClimbQuery(OutHit, Start, End, Shape, Channel);
+
+	return bHit;
+}
+
+ECollisionChannel UZCCharacterMovementComponent::GetClimbQueryChannel(EZCClimbProbe Probe) const
+{
+	// Props that aren't climbable still block standing up
+	if (Probe == EZCClimbProbe::LedgeClearance)
+		return UpdatedComponent->GetCollisionObjectType();
+
+	return ClimbTraceChannel;
+}
+
+bool UZCCharacterMovementComponent::FindCachedClimbQuery(FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionShape& Shape, ECollisionChannel Channel) const
+{
+	// Results only hold for the frame and transform they were gathered with
+	if (QueryCacheFrame != GFrameCounter || !QueryCacheTransform.Equals(UpdatedComponent->GetComponentTransform(), 0.f))
+	{
+		QueryCache.Reset();
+		QueryCacheFrame = GFrameCounter;
+		QueryCacheTransform = UpdatedComponent->GetComponentTransform();
+	}
+
+	FVector Direction;
+	float Length;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+
+	for (const FZCCachedClimbQuery& Cached : QueryCache)
+	{
+		if (!Cached.IsSameRay(Start, Direction, Shape, Channel) || !Cached.CanAnswer(Length))
+			continue;
+
+		if (Cached.Hit.bBlockingHit && Cached.Hit.Distance <= Length)
+		{
+			OutHit = Cached.Hit;
+			OutHit.TraceEnd = End;
+			OutHit.Time = Length > 0.f ? Cached.Hit.Distance / Length : 0.f;
+		}
+		else
+		{
+			OutHit = FHitResult(Start, End);
+		}
+
+		++QueryCounters.CacheHits;
+		++ClimbingProfile.QueryCacheHits;
+		INC_DWORD_STAT(STAT_ZCQueryCacheHits);
+		return true;
+	}
+
+	++QueryCounters.CacheMisses;
+	++ClimbingProfile.QueryCacheMisses;
+	INC_DWORD_STAT(STAT_ZCQueryCacheMisses);
+	return false;
+}
+
+void UZCCharacterMovementComponent::CacheClimbQuery(const FHitResult& Hit, const FVector& Start, const FVector& End, const FCollisionShape& Shape, ECollisionChannel Channel) const
+{
+	FVector Direction;
+	float Length;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+
+	// A longer miss along a ray we already have replaces it, since it answers everything the shorter one did
+	FZCCachedClimbQuery* Cached = QueryCache.FindByPredicate([&](const FZCCachedClimbQuery& Entry) { return Entry.IsSameRay(Start, Direction, Shape, Channel); });
+	if (!Cached)
+		Cached = &QueryCache.AddDefaulted_GetRef();
+
+	Cached->Start = Start;
+	Cached->Direction = Direction;
+	Cached->Length = Length;
+	Cached->ShapeType = Shape.ShapeType;
+	Cached->ShapeExtent = Shape.GetExtent();
+	Cached->Channel = Channel;
+	Cached->Hit = Hit;
+}
+
+const TArray<FHitResult>* UZCCharacterMovementComponent::ConsumeAsyncClimbQuery(EZCClimbProbe Probe, int32 ProbeIndex, bool bMulti, const FVector& Start, const FVector& End, const FCollisionShape& Shape) const
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	FZCAsyncClimbProbe& Slot = AsyncProbes.FindOrAdd(MakeClimbProbeKey(Probe, ProbeIndex));
+
+	// Pick up the request from a previous frame if it's done. Handles only stay valid for a couple of frames so drop any that expired.
+	if (Slot.PendingHandle.IsValid())
+	{
+		FTraceDatum Datum;
+		if (World->QueryTraceData(Slot.PendingHandle, Datum))
+		{
+			Slot.Hits = MoveTemp(Datum.OutHits);
+			Slot.ResultFrame = Slot.PendingFrame;
+			Slot.bHasResult = true;
+			Slot.PendingHandle = FTraceHandle();
+		}
+		else if (!World->IsTraceHandleValid(Slot.PendingHandle, false))
+		{
+			Slot.PendingHandle = FTraceHandle();
+		}
+	}
+
+	// Queue the next request so it's ready by the time this probe comes around again
+	if (!Slot.PendingHandle.IsValid())
+	{
+		const EAsyncTraceType TraceType = bMulti ? EAsyncTraceType::Multi : EAsyncTraceType::Single;
+		const ECollisionChannel Channel = GetClimbQueryChannel(Probe);
+		Slot.PendingHandle = Shape.IsLine()
+			? World->AsyncLineTraceByChannel(TraceType, Start, End, Channel, ClimbQueryParams)
+			: World->AsyncSweepByChannel(TraceType, Start, End, FQuat::Identity, Channel, Shape, ClimbQueryParams);
+		Slot.PendingFrame = GFrameCounter;
+		++QueryCounters.Issued;
+		CountClimbQuery(Shape, 0);
+	}
+
+	const bool bIsFresh = Slot.bHasResult && GFrameCounter - Slot.ResultFrame <= static_cast<uint64>(MaxAsyncQueryStaleFrames);
+	if (!bIsFresh)
+	{
+		++QueryCounters.SyncFallbacks;
+		return nullptr;
+	}
+
+	++QueryCounters.Consumed;
+	ClimbingProfile.HitsReturned += Slot.Hits.Num();
+	INC_DWORD_STAT(STAT_ZCAsyncResultsUsed);
+	INC_DWORD_STAT_BY(STAT_ZCHitsReturned, Slot.Hits.Num());
+	return &Slot.Hits;
+}
+
+void UZCCharacterMovementComponent::CountClimbQuery(const FCollisionShape& Shape, int32 NumHits) const
+{
+	if (Shape.IsLine())
+	{
+		++ClimbingProfile.LineTraces;
+		INC_DWORD_STAT(STAT_ZCLineTraces);
+	}
+	else
+	{
+		++ClimbingProfile.Sweeps;
+		INC_DWORD_STAT(STAT_ZCSweeps);
+	}
+
+	ClimbingProfile.HitsReturned += NumHits;
+	INC_DWORD_STAT_BY(STAT_ZCHitsReturned, NumHits);
+}
+
 void UZCCharacterMovementComponent::DrawClimbDownDebug(const FVector& Start, const FVector& End) const
 {
 	if (!bIsDebugEnabled)
@@ -503,7 +1747,7 @@ void UZCCharacterMovementComponent::DrawDebug(FVector SweepLocation) const
 
 	// collider sweep
 	FColor SweepColor = FColor::White;
-	if (CurrentWallHits.Num() > 0)
+	if (CurrentWallContacts.Num() > 0)
 	{
 		if (IsClimbDashing())
 			SweepColor = FColor::Magenta;
@@ -516,22 +1760,22 @@ void UZCCharacterMovementComponent::DrawDebug(FVector SweepLocation) const
 	}
 	DrawDebugCapsule(GetWorld(), SweepLocation, CollisionCapsulHalfHeight, CollisionCapsulRadius, FQuat::Identity, SweepColor);
 
-	for (const FHitResult& WallHit : CurrentWallHits)
+	for (const FZCClimbContact& WallContact : CurrentWallContacts)
 	{
 		// hit
-		DrawDebugSphere(GetWorld(), WallHit.ImpactPoint, 5, 26, FColor::Blue);
+		DrawDebugSphere(GetWorld(), WallContact.ImpactPoint, 5, 26, FColor::Blue);
 
 		// hit surface
-		const FVector Normal = WallHit.Normal;
+		const FVector Normal = WallContact.Normal;
 		const FVector Right = UpdatedComponent->GetRightVector();
-		const FVector Up = FVector::CrossProduct(Right, WallHit.Normal);
-		DrawDebugLine(GetWorld(), WallHit.ImpactPoint, WallHit.ImpactPoint + (Normal * 100), FColor::Cyan);
-		//DrawDebugLine(GetWorld(), WallHit.ImpactPoint, WallHit.ImpactPoint + (Right * 100), FColor::Red); // Showing the players right doesn't serve a purpose
-		DrawDebugLine(GetWorld(), WallHit.ImpactPoint, WallHit.ImpactPoint + (Up * 100), FColor::Green);
+		const FVector Up = FVector::CrossProduct(Right, WallContact.Normal);
+		DrawDebugLine(GetWorld(), WallContact.ImpactPoint, WallContact.ImpactPoint + (Normal * 100), FColor::Cyan);
+		//DrawDebugLine(GetWorld(), WallContact.ImpactPoint, WallContact.ImpactPoint + (Right * 100), FColor::Red); // Showing the players right doesn't serve a purpose
+		DrawDebugLine(GetWorld(), WallContact.ImpactPoint, WallContact.ImpactPoint + (Up * 100), FColor::Green);
 	
 		// hit 2D surface normal
-		const FVector Normal2DDiff = Normal - WallHit.Normal.GetSafeNormal2D();
+		const FVector Normal2DDiff = Normal - WallContact.Normal.GetSafeNormal2D();
 		if (!Normal2DDiff.IsNearlyZero())
-			DrawDebugLine(GetWorld(), WallHit.ImpactPoint, WallHit.ImpactPoint + (WallHit.Normal.GetSafeNormal2D() * 100), FColor::Magenta);
+			DrawDebugLine(GetWorld(), WallContact.ImpactPoint, WallContact.ImpactPoint + (WallContact.Normal.GetSafeNormal2D() * 100), FColor::Magenta);
 	}
 }
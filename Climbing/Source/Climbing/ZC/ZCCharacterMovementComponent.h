@@ -4,8 +4,126 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbingQueries.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbContactManifold.h"
+#include "Climbing/ZC/ZCClimbContactTracker.h"
+#include "Climbing/ZC/ZCClimbValidation.h"
+#include "Climbing/ZC/ZCClimbReplicatedState.h"
+#include "Climbing/ZC/ZCTypes.h"
 #include "ZCCharacterMovementComponent.generated.h"
 
+// How much work a climber does per tick, driven by how significant the character is to the player
+UENUM(BlueprintType)
+enum class EZCClimbingLOD : uint8
+{
+	High,
+	Medium,
+	Low,
+};
+
+USTRUCT(BlueprintType)
+struct FZCClimbingLODSettings
+{
+	GENERATED_BODY()
+
+	FZCClimbingLODSettings() {}
+	FZCClimbingLODSettings(int32 InWallSweepInterval, int32 InSurfaceInfoInterval, int32 InLedgeAndFloorCheckInterval, bool bInSmoothRotation)
+		: WallSweepInterval(InWallSweepInterval), SurfaceInfoInterval(InSurfaceInfoInterval), LedgeAndFloorCheckInterval(InLedgeAndFloorCheckInterval), bSmoothRotation(bInSmoothRotation) {}
+
+	// Ticks between wall sweeps. Cached wall hits are reused in between.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1", ClampMax = "30"))
+	int32 WallSweepInterval = 1;
+	// Ticks between surface normal/position updates. The last surface is reused in between.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1", ClampMax = "30"))
+	int32 SurfaceInfoInterval = 1;
+	// Ticks between checks for climbing down onto a floor or up over a ledge
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1", ClampMax = "30"))
+	int32 LedgeAndFloorCheckInterval = 1;
+	// When off the character turns to face the surface immediately instead of interpolating
+	UPROPERTY(EditAnywhere)
+	bool bSmoothRotation = true;
+};
+
+// Everything the climbing animation needs, copied out of the movement component once per tick so the anim graph can read it on a worker thread
+USTRUCT(BlueprintType)
+struct FZCClimbingAnimState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	bool bIsClimbing = false;
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	bool bIsClimbDashing = false;
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	bool bIsLedgeClimbing = false;
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	FVector ClimbDashDirection = FVector::ZeroVector;
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	FVector ClimbSurfaceNormal = FVector::ZeroVector;
+};
+
+/**
+ * Saved move that carries climbing intent so it can be replayed on the client and sent to the server in the compressed flags
+ */
+class FSavedMove_ZCCharacter : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	// Climb intent rides in the custom compressed flags
+	static constexpr uint8 FLAG_WantsToClimb = FLAG_Custom_0;
+	static constexpr uint8 FLAG_WantsToClimbDash = FLAG_Custom_1;
+
+	FSavedMove_ZCCharacter() : bSavedWantsToClimb(false), bSavedWantsToClimbDash(false) {}
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+
+	uint8 bSavedWantsToClimb : 1;
+	uint8 bSavedWantsToClimbDash : 1;
+	bool bSavedHasClimbStartClaim = false;
+	FZCClimbContactClaim SavedClimbStartClaim;
+	float SavedClimbDashTime = 0.f;
+	FVector SavedClimbDashDirection = FVector::ZeroVector;
+	float SavedClimbingTimeAccumulator = 0.f;
+};
+
+class FNetworkPredictionData_Client_ZCCharacter : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_ZCCharacter(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+// Move data with the contact a climb start was decided on, only sent while the client is asking to start climbing
+class FZCCharacterNetworkMoveData : public FCharacterNetworkMoveData
+{
+public:
+	typedef FCharacterNetworkMoveData Super;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	bool bHasClimbStartClaim = false;
+	FVector_NetQuantize10 ClimbStartPosition;
+	FVector_NetQuantizeNormal ClimbStartNormal;
+};
+
+class FZCCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+public:
+	FZCCharacterNetworkMoveDataContainer();
+
+	FZCCharacterNetworkMoveData MoveDataStorage[3];
+};
+
 /**
  * 
  */
@@ -14,8 +132,17 @@ class CLIMBING_API UZCCharacterMovementComponent : public UCharacterMovementComp
 {
 	GENERATED_BODY()
 
+	// Crowd climbers share this component's tuning values
+	friend class UZCClimbingCrowdSubsystem;
+	friend class FSavedMove_ZCCharacter;
+	friend class UZCClimbingBatchSubsystem;
+#if WITH_DEV_AUTOMATION_TESTS
+	// The automation tests tick it directly
+	friend class FZCClimbingTestWorld;
+#endif
+
 public:
-	UZCCharacterMovementComponent(){}
+	UZCCharacterMovementComponent();
 	virtual ~UZCCharacterMovementComponent(){}
 
 	UFUNCTION(BlueprintCallable)
@@ -36,11 +163,51 @@ public:
 	UFUNCTION(BlueprintPure)
 	FVector GetClimbSurfaceNormal() const;
 
+	// Climbing state as of the end of this component's last tick. Animation should read it through UZCClimbingAnimInstance instead.
+	const FZCClimbingAnimState& GetClimbingAnimState() const { return ClimbingAnimState; }
+
+	UFUNCTION(BlueprintPure)
+	int32 GetAsyncQueriesIssued() const { return QueryCounters.Issued; }
+
+	UFUNCTION(BlueprintPure)
+	int32 GetAsyncQueriesConsumed() const { return QueryCounters.Consumed; }
+
+	// Corrections the server sent this client while either side was climbing
+	UFUNCTION(BlueprintPure)
+	int32 GetNumClimbingCorrections() const { return NumClimbingCorrections; }
+
+	// Fraction of single hit climbing queries answered from the per tick query cache
+	UFUNCTION(BlueprintPure)
+	float GetQueryCacheHitRate() const;
+
+	// Fraction of ticks where the wall sweep was skipped because nothing climbable was nearby
+	UFUNCTION(BlueprintPure)
+	float GetWallSweepSkipRatio() const;
+
+	// Fraction of wall sweeps replaced by carrying the tracked contacts along and checking them with a single ray
+	UFUNCTION(BlueprintPure)
+	float GetWallSweepTrackedRatio() const;
+
+	const FZCClimbingProfile& GetClimbingProfile() const { return ClimbingProfile; }
+	void ResetClimbingProfile() { ClimbingProfile.Reset(); }
+
+	UFUNCTION(BlueprintCallable)
+	void SetClimbingLOD(EZCClimbingLOD NewLOD);
+
+	UFUNCTION(BlueprintPure)
+	EZCClimbingLOD GetClimbingLOD() const { return ClimbingLOD; }
+
 	void WantsClimbing();
 	void CancelClimbing();
 
+	// Called by UZCClimbingBatchSubsystem from worker threads once this component has moved for the frame. Only touches this component's state.
+	void RunBatchedClimbingQueries();
+	// Called by UZCClimbingBatchSubsystem on the game thread after every climber's batched queries are done
+	void FinishBatchedClimbingQueries();
+
 private:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
 	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
@@ -48,14 +215,48 @@ private:
 	virtual float GetMaxSpeed() const override;
 	virtual float GetMaxAcceleration() const override;
 
+	// Network prediction
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	virtual void OnClientCorrectionReceived(class FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
+	bool ValidateClientClimbStart(const FZCClimbContactClaim* Claim);
+	bool IsClimbStartClaimPlausible(const FZCClimbContactClaim& Claim) const;
+	bool ConfirmClimbStartClaim(const FZCClimbContactClaim& Claim);
+	void CacheRecentSurfaces();
+	void UpdateClimbStartClaim();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	bool IsFollowingReplicatedClimbState() const;
+	void PublishReplicatedClimbState();
+	void FollowReplicatedClimbState(float DeltaTime);
+
 	void SweepAndStoreWallHits();
+	bool ShouldSweepForWalls();
+	const FZCClimbingLODSettings& GetClimbingLODSettings() const;
+	bool ShouldRunClimbingLODStage(int32 Interval) const;
+	bool ShouldRunClimbingLODStage(int32 Interval, uint32 Frame) const;
+	void CheckClimbTickBudget(int32 TickQueries, uint64 TickCycles);
 	bool CanStartClimbing() const;
-	bool HorizontalClimbCheck(const FHitResult& WallHit) const;
-	bool VerticalClimbCheck(const FHitResult& WallHit) const;
-	bool EyeHeightTrace(const float TraceDistance) const;
+	bool CanStartClimbingFromGrid(bool& bOutCanClimb) const;
+	const class AZCClimbGrid* FindClimbGrid(const FVector& Location) const;
+	bool AreWallHitsStatic() const;
+	bool HorizontalClimbCheck(const FZCClimbContact& WallContact) const;
+	bool IsFacingSurface(const FVector& SurfaceNormal) const;
+	bool VerticalClimbCheck(const FZCClimbContact& WallContact, int32 HitIndex) const;
+	bool EyeHeightTrace(const float TraceDistance, EZCClimbProbe Probe, int32 ProbeIndex = 0) const;
+	FVector GetEyeHeightLocation() const;
 
 	void PhysClimbing(float DeltaTime, int32 Iterations);
+	bool ClimbingSubstep(float DeltaTime, int32 Iterations);
+	void UpdateClimbingMeshInterpolation();
+	void ResetClimbingMeshInterpolation();
 	void ComputeSurfaceInfo();
+	void GatherSurfaceInfo(FVector& OutNormal, FVector& OutPosition) const;
+	bool ConsumeBatchedSurfaceInfo();
+	bool CanReprojectSurfaceInfo() const;
+	bool ReprojectSurfaceInfo();
+	bool TrackWallContacts();
+	void GatherSurfaceSamples(TArray<FZCSurfaceSample, TInlineAllocator<8>>& OutSamples) const;
 	void ComputeClimbingVelocity(float DeltaTime);
 	bool ShouldStopClimbing();
 	void StopClimbing(float DeltaTime, int32 Iterations);
@@ -63,6 +264,10 @@ private:
 	FQuat GetSmoothClimbingRotation(float DeltaTime) const;
 	void SnapToClimbingSurface(float DeltaTime) const;
 
+	bool CanClimbDash() const;
+	float GetClimbDashSpeed() const;
+	float GetClimbingRotationSpeed() const;
+	float GetClimbingSnapSpeed() const;
 	void CacheClimbDashDirection();
 	void UpdateClimbDashState(float DeltaTime);
 	void AlignClimbDashDirection();
@@ -71,9 +276,32 @@ private:
 	bool ClimbDownToFloor() const;
 	bool CheckFloor(FHitResult& OutFloorHit) const;
 	bool TryClimbUpLedge();
+	bool CanClimbUpLedge() const;
+	bool CanClimbUpLedgeFromGraph(bool& bOutCanClimbUp) const;
+	const class AZCLedgeGraph* FindLedgeGraph(const FVector& Location) const;
 	bool HasReachedLedge() const;
 	bool IsLedgeWalkable(const FVector& LocationToCheck) const;
 	bool CanMoveToLedgeClimbLocation() const;
+	// Picks up the mesh's anim instance and listens to its montages. Runs again whenever the mesh initializes its animation, which can swap in a new instance.
+	UFUNCTION()
+	void BindAnimInstance();
+	UFUNCTION()
+	void OnLedgeClimbMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted);
+	// Ends without blending out if it's stopped outright
+	UFUNCTION()
+	void OnLedgeClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted);
+	void PublishClimbingAnimState();
+
+	// All climbing scene queries go through here so they can be answered either blocking or from last frame's async results
+	bool ClimbQueryMulti(TArray<FHitResult>& OutHits, EZCClimbProbe Probe, const FVector& Start, const FVector& End, const FCollisionShape& Shape) const;
+	bool ClimbQuerySingle(FHitResult& OutHit, EZCClimbProbe Probe, int32 ProbeIndex, const FVector& Start, const FVector& End, const FCollisionShape& Shape = FCollisionShape::LineShape) const;
+	bool UsesAsyncClimbQueries() const { return bUseAsyncClimbingQueries && !bIsClimbingTickBatched; }
+	// The probe's last async result if it's fresh enough, otherwise null. Either way queues the next request.
+	const TArray<FHitResult>* ConsumeAsyncClimbQuery(EZCClimbProbe Probe, int32 ProbeIndex, bool bMulti, const FVector& Start, const FVector& End, const FCollisionShape& Shape) const;
+	void CountClimbQuery(const FCollisionShape& Shape, int32 NumHits) const;
+	bool FindCachedClimbQuery(FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionShape& Shape, ECollisionChannel Channel) const;
+	void CacheClimbQuery(const FHitResult& Hit, const FVector& Start, const FVector& End, const FCollisionShape& Shape, ECollisionChannel Channel) const;
+	ECollisionChannel GetClimbQueryChannel(EZCClimbProbe Probe) const;
 
 	UPROPERTY(Category = "Character Movement: Climbing", EditAnywhere)
 	int CollisionCapsulRadius = 50;
@@ -103,9 +331,96 @@ private:
 	float ClimbingDistanceFromSurface = 45.f;
 	UPROPERTY(Category = "Character Movement: Climbing", EditAnywhere, meta = (ClampMin = "1.0", ClampMax = "500.0"))
 	float FloorCheckDistance = 120.f;
+	// Most surface probes ComputeSurfaceInfo will fire in a tick after merging wall hits on the same face. The faces with the most hits win.
+	UPROPERTY(Category = "Character Movement: Climbing", EditAnywhere, meta = (ClampMin = "1", ClampMax = "32"))
+	int32 MaxSurfaceSamplesPerTick = 8;
+
+	UPROPERTY(Category = "Character Movement: Climbing|LOD", EditAnywhere)
+	FZCClimbingLODSettings MediumLODSettings = FZCClimbingLODSettings(2, 2, 2, true);
+	UPROPERTY(Category = "Character Movement: Climbing|LOD", EditAnywhere)
+	FZCClimbingLODSettings LowLODSettings = FZCClimbingLODSettings(4, 4, 4, false);
+
+	// Answers climb start checks from a baked AZCClimbGrid when the character is inside one and only touching static geometry
+	UPROPERTY(Category = "Character Movement: Climbing", EditAnywhere)
+	bool bUseClimbGrid = true;
+	// Answers ledge climb checks from a baked AZCLedgeGraph when the character is inside one and only touching static geometry
+	UPROPERTY(Category = "Character Movement: Climbing", EditAnywhere)
+	bool bUseLedgeGraph = true;
+
+	// Skips the wall sweep entirely unless there's geometry within reach or the character is trying to climb
+	UPROPERTY(Category = "Character Movement: Climbing|Proximity", EditAnywhere)
+	bool bUseProximityGating = true;
+	// Extra distance past the sweep's reach that the proximity overlap covers. The overlap is only re-run after moving this far.
+	UPROPERTY(Category = "Character Movement: Climbing|Proximity", EditAnywhere, meta = (EditCondition = "bUseProximityGating", ClampMin = "10.0", ClampMax = "1000.0"))
+	float ProximityCheckMargin = 150.f;
+
+	// Submits climbing probes as async scene queries and uses the previous frame's results instead of blocking the game thread
+	UPROPERTY(Category = "Character Movement: Climbing|Async", EditAnywhere)
+	bool bUseAsyncClimbingQueries = false;
+	// How many frames old an async result may be before falling back to a blocking query
+	UPROPERTY(Category = "Character Movement: Climbing|Async", EditAnywhere, meta = (EditCondition = "bUseAsyncClimbingQueries", ClampMin = "1", ClampMax = "10"))
+	int32 MaxAsyncQueryStaleFrames = 2;
+
+	// While climbing a single flat surface, carries the last probed contacts along with the character instead of re-probing every tick.
+	// A single ray at the wall checks them each tick, and a full probe runs once the character moves or turns past the limits below.
+	// Until then the floor and ledge checks answer from one trace each, made ContactReprobeDistance longer or higher than they need.
+	UPROPERTY(Category = "Character Movement: Climbing|Tracking", EditAnywhere)
+	bool bUseIncrementalContactTracking = true;
+	UPROPERTY(Category = "Character Movement: Climbing|Tracking", EditAnywhere, meta = (EditCondition = "bUseIncrementalContactTracking", ClampMin = "1.0", ClampMax = "200.0"))
+	float ContactReprobeDistance = 25.f;
+	// How far the character may turn, and how far contact normals may be from the surface normal, before contacts need a full probe
+	UPROPERTY(Category = "Character Movement: Climbing|Tracking", EditAnywhere, meta = (EditCondition = "bUseIncrementalContactTracking", ClampMin = "0.0", ClampMax = "45.0"))
+	float ContactReprobeAngle = 10.f;
+	// How far the validation ray's hit may be from where the tracked surface says it should be
+	UPROPERTY(Category = "Character Movement: Climbing|Tracking", EditAnywhere, meta = (EditCondition = "bUseIncrementalContactTracking", ClampMin = "0.1", ClampMax = "50.0"))
+	float ContactValidationTolerance = 3.f;
+
+	// Checks a client's climb start against the contact it claims to have started on: first against surfaces the server probed around
+	// the character in the last moment, then with a ray at the contact and one checking nothing the character collides with is in the way.
+	// Only a claim neither confirms gets the full server side checks.
+	UPROPERTY(Category = "Character Movement: Climbing|Validation", EditAnywhere)
+	bool bValidateClimbStartClaims = true;
+	// How far the claimed contact may be from what the server finds there
+	UPROPERTY(Category = "Character Movement: Climbing|Validation", EditAnywhere, meta = (EditCondition = "bValidateClimbStartClaims", ClampMin = "1.0", ClampMax = "100.0"))
+	float ClimbClaimDistanceTolerance = 15.f;
+	UPROPERTY(Category = "Character Movement: Climbing|Validation", EditAnywhere, meta = (EditCondition = "bValidateClimbStartClaims", ClampMin = "0.0", ClampMax = "45.0"))
+	float ClimbClaimAngleTolerance = 15.f;
+	// Oldest a server side surface sample may be and still confirm a claim
+	UPROPERTY(Category = "Character Movement: Climbing|Validation", EditAnywhere, meta = (EditCondition = "bValidateClimbStartClaims", ClampMin = "0.0", ClampMax = "5.0"))
+	float ClimbClaimCacheMaxAge = 0.5f;
+
+	// Replicates the climbing surface and dash state to simulated proxies, which follow it instead of running any climbing queries
+	UPROPERTY(Category = "Character Movement: Climbing|Replication", EditAnywhere)
+	bool bUseReplicatedClimbState = true;
+	// How fast a simulated proxy's climbing normal turns toward the replicated one, in degrees per second
+	UPROPERTY(Category = "Character Movement: Climbing|Replication", EditAnywhere, meta = (EditCondition = "bUseReplicatedClimbState", ClampMin = "10.0", ClampMax = "3600.0"))
+	float ReplicatedNormalSmoothingSpeed = 360.f;
+	UPROPERTY(Category = "Character Movement: Climbing|Replication", EditAnywhere, meta = (EditCondition = "bUseReplicatedClimbState", ClampMin = "0.0", ClampMax = "60.0"))
+	float ReplicatedDistanceSmoothingSpeed = 10.f;
+
+	// Reuses single hit climbing queries along the same ray within a tick, e.g. the eye height trace run once per wall hit. Dropped whenever the character moves.
+	UPROPERTY(Category = "Character Movement: Climbing|Queries", EditAnywhere)
+	bool bCacheClimbQueriesPerTick = true;
+
+	// Runs the climbing simulation at FixedClimbingRate no matter the frame rate, so probe cost and behavior don't depend on it
+	UPROPERTY(Category = "Character Movement: Climbing|Substepping", EditAnywhere)
+	bool bUseFixedClimbingTimestep = false;
+	UPROPERTY(Category = "Character Movement: Climbing|Substepping", EditAnywhere, meta = (EditCondition = "bUseFixedClimbingTimestep", ClampMin = "10.0", ClampMax = "240.0"))
+	float FixedClimbingRate = 60.f;
+	// Most steps run in one update. Time past that is dropped so a long hitch can't cascade into more work.
+	UPROPERTY(Category = "Character Movement: Climbing|Substepping", EditAnywhere, meta = (EditCondition = "bUseFixedClimbingTimestep", ClampMin = "1", ClampMax = "16"))
+	int32 MaxClimbingSubsteps = 4;
+	// Moves the mesh between the last two simulation steps so it doesn't visibly step at the simulation rate
+	UPROPERTY(Category = "Character Movement: Climbing|Substepping", EditAnywhere, meta = (EditCondition = "bUseFixedClimbingTimestep"))
+	bool bInterpolateClimbingMesh = true;
 
 	UPROPERTY(Category = "Character Movement: Climbing", EditDefaultsOnly)
 	UCurveFloat* ClimbDashCurve;
+	// Baked dash, rotation and snap curves. Used instead of ClimbDashCurve and the fixed rotation and snap speeds when set.
+	UPROPERTY(Category = "Character Movement: Climbing", EditDefaultsOnly)
+	class UZCClimbMotionProfile* ClimbMotionProfile;
+	// End of the dash curve's time range, looked up once in BeginPlay
+	float ClimbDashEndTime = 0.f;
 	FVector ClimbDashDirection;
 	bool bWantsToClimbDash = false;
 	float CurrentClimbDashTime;
@@ -115,15 +430,97 @@ private:
 	UPROPERTY()
 	UAnimInstance* AnimInstance;
 	bool bIsInLedgeClimb = false;
+	// Set while the ledge climb montage plays. Cleared once it blends out or ends, on leaving climbing, or when the anim instance is initialized.
+	bool bIsLedgeClimbMontagePlaying = false;
+	FZCClimbingAnimState ClimbingAnimState;
 
-	TArray<FHitResult> CurrentWallHits;
+	FZCClimbContactManifold CurrentWallContacts;
+	// Reused by every wall sweep, so it stops allocating once it has grown to fit
+	TArray<FHitResult> WallSweepHits;
 	FCollisionQueryParams ClimbQueryParams;
 
+	UPROPERTY(Transient)
+	TArray<class AZCClimbGrid*> ClimbGrids;
+	UPROPERTY(Transient)
+	TArray<class AZCLedgeGraph*> LedgeGraphs;
+	float MinHorizontalClimbAngleCos = 1.f;
+
+	FVector LastProximityCheckLocation;
+	bool bHasProximityResult = false;
+	bool bIsNearClimbableSurface = false;
+	bool bWallHitsStale = false;
+	int32 WallSweepsRun = 0;
+	int32 WallSweepsSkipped = 0;
+	int32 WallSweepsTracked = 0;
+
+	// Mutable for the const floor and ledge checks, which keep what they find on it
+	mutable FZCClimbContactTracker ContactTracker;
+	float ContactReprobeAngleCos = 1.f;
+
+	EZCClimbingLOD ClimbingLOD = EZCClimbingLOD::High;
+	uint32 ClimbingLODFrame = 0;
+	// Run every stage on the next tick regardless of LOD, so a climber never acts on cached data from before a change
+	bool bForceClimbingLODRefresh = true;
+	// Same for the next climbing step, which only the step itself clears. Climbing starts after that tick's step has already run.
+	bool bForceClimbingStepRefresh = true;
+
+	mutable TMap<uint32, FZCAsyncClimbProbe> AsyncProbes;
+	mutable FZCClimbQueryCounters QueryCounters;
+	mutable FZCClimbingProfile ClimbingProfile;
+	// UZCClimbingSettings' channel, read once at BeginPlay
+	ECollisionChannel ClimbTraceChannel = ECC_ZCClimbable;
+	// Kept out of the profile so resetting it between frames doesn't bring the budget warning back
+	bool bHasWarnedAboutClimbBudget = false;
+
+	mutable TArray<FZCCachedClimbQuery, TInlineAllocator<8>> QueryCache;
+	mutable uint64 QueryCacheFrame = 0;
+	mutable FTransform QueryCacheTransform;
+
+	// Hands this component's wall sweep and first surface info of each update to UZCClimbingBatchSubsystem, which runs them for every climber in parallel.
+	// Batched components always use blocking queries, async ones go through world state the batch's worker threads can't share.
+	UPROPERTY(Category = "Character Movement: Climbing|Batching", EditAnywhere)
+	bool bUseBatchedClimbingTick = false;
+	bool bIsClimbingTickBatched = false;
+
+	// Surface info the batch worked out for the start of the next update, only used if the character hasn't moved since
+	FVector BatchedClimbingNormal = FVector::ZeroVector;
+	FVector BatchedClimbingPosition = FVector::ZeroVector;
+	FTransform BatchedSurfaceTransform;
+	uint32 BatchedSurfaceFrame = 0;
+	bool bHasBatchedSurfaceInfo = false;
+
+	// Debug drawing is left for the game thread when the sweep runs on a worker
+	FVector LastWallSweepLocation = FVector::ZeroVector;
+	bool bPendingWallSweepDebug = false;
+
+	// Simulation time not yet consumed by a fixed climbing step
+	float ClimbingTimeAccumulator = 0.f;
+	// Updated component's transform before the latest fixed climbing step, for mesh interpolation
+	FTransform PreviousClimbingStepTransform;
+	bool bClimbingMeshInterpolated = false;
+
 	FVector CurrentClimbingNormal;
 	FVector CurrentClimbingPosition;
 
 	bool bWantsToClimb = false;
 
+	// Last dash flag received from the client, so the server only starts a dash on the move where the client started it
+	bool bLastClientClimbDashFlag = false;
+	int32 NumClimbingCorrections = 0;
+
+	// Client: the contact the last climb start was decided on, sent to the server with the moves asking to climb
+	FZCClimbContactClaim ClimbStartClaim;
+	bool bHasClimbStartClaim = false;
+	// Server: surfaces probed around a remotely controlled character, for confirming its climb start claims
+	FZCRecentSurfaceCache RecentSurfaces;
+	float ClimbClaimAngleCos = 1.f;
+	FZCCharacterNetworkMoveDataContainer NetworkMoveDataContainer;
+
+	// Server: written every climbing tick. Simulated proxies: what they smooth toward.
+	UPROPERTY(Replicated)
+	FZCReplicatedClimbState ReplicatedClimbState;
+	float ReplicatedContactDistance = 0.f;
+
 private:
 	void DrawClimbDownDebug(const FVector& Start, const FVector& End) const;
 	void DrawEyeTraceDebug(const FVector& Start, const FVector& End) const;
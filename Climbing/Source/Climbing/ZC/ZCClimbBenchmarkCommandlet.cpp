@@ -0,0 +1,313 @@
+#include "Climbing/ZC/ZCClimbBenchmarkCommandlet.h"
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbTerrain.h"
+#include "Climbing/Climbing.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/PlatformMemory.h"
+#include "InputActionValue.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UZCClimbBenchmarkCommandlet::UZCClimbBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UZCClimbBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumCharacters = 100;
+	int32 NumFrames = 1800;
+	float WallDensity = 4.f;
+	float WallTilt = 0.f;
+	int32 NumOverhangs = 0;
+	int32 NumLedges = 0;
+	int32 NumStairs = 0;
+	int32 NumLandscapePatches = 0;
+	float ClimbFraction = 0.5f;
+	int32 Seed = 1;
+	const bool bLegacyWalls = FParse::Param(*Params, TEXT("LegacyWalls"));
+	FString MapName;
+	FString CharacterClassName = TEXT("/Game/ZC/Blueprints/BP_ZCCharacter.BP_ZCCharacter_C");
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("ClimbBenchmark") / FString::Printf(TEXT("ClimbBenchmark_%s.csv"), *FDateTime::Now().ToString());
+
+	FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("WallDensity="), WallDensity);
+	FParse::Value(*Params, TEXT("WallTilt="), WallTilt);
+	FParse::Value(*Params, TEXT("Overhangs="), NumOverhangs);
+	FParse::Value(*Params, TEXT("Ledges="), NumLedges);
+	FParse::Value(*Params, TEXT("Stairs="), NumStairs);
+	FParse::Value(*Params, TEXT("Patches="), NumLandscapePatches);
+	FParse::Value(*Params, TEXT("ClimbFraction="), ClimbFraction);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("CharacterClass="), CharacterClassName);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	NumCharacters = FMath::Max(1, NumCharacters);
+	NumFrames = FMath::Max(1, NumFrames);
+	ClimbFraction = FMath::Clamp(ClimbFraction, 0.f, 1.f);
+
+	// The game's character if it can be loaded, so the tuning and animation match what ships
+	UClass* CharacterClass = LoadClass<AZCClimbingCharacter>(nullptr, *CharacterClassName);
+	if (!CharacterClass)
+	{
+		UE_LOG(LogZCClimbing, Warning, TEXT("Couldn't load %s, using AZCClimbingCharacter"), *CharacterClassName);
+		CharacterClass = AZCClimbingCharacter::StaticClass();
+	}
+
+	UWorld* World = CreateBenchmarkWorld(MapName);
+	if (!World)
+		return 1;
+
+	FRandomStream Random(Seed);
+
+	// Roughly 5m x 5m of ground per character
+	const float FieldSize = FMath::Max(2000.f, FMath::Sqrt(static_cast<float>(NumCharacters)) * 500.f);
+	const int32 NumClimbers = FMath::RoundToInt(NumCharacters * ClimbFraction);
+
+	const int32 NumWalls = FMath::Max(1, FMath::RoundToInt(WallDensity * FMath::Square(FieldSize / 1000.f)));
+
+	TArray<FTransform> ClimbStarts;
+	if (MapName.IsEmpty() && bLegacyWalls)
+	{
+		GenerateLegacyWalls(World, FieldSize, NumWalls, Random, ClimbStarts);
+	}
+	else if (MapName.IsEmpty())
+	{
+		FZCClimbTerrainSettings TerrainSettings;
+		TerrainSettings.Seed = Seed;
+		TerrainSettings.FieldSize = FieldSize;
+		TerrainSettings.NumWalls = NumWalls;
+		TerrainSettings.MaxWallTilt = WallTilt;
+		TerrainSettings.NumOverhangs = NumOverhangs;
+		TerrainSettings.NumLedges = NumLedges;
+		TerrainSettings.NumStairs = NumStairs;
+		TerrainSettings.NumLandscapePatches = NumLandscapePatches;
+
+		if (const AZCClimbTerrain* Terrain = AZCClimbTerrain::SpawnClimbTerrain(World, TerrainSettings))
+		{
+			ClimbStarts = Terrain->GetClimbStarts();
+			UE_LOG(LogZCClimbing, Display, TEXT("Generated %d boxes"), Terrain->GetNumPrimitives());
+		}
+	}
+
+	// Actors placed in the level only start ticking once play has begun
+	World->BeginPlay();
+	if (!World->HasBegunPlay())
+		World->GetWorldSettings()->NotifyBeginPlay();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	TArray<FBenchmarkCharacter> Characters;
+	for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; ++CharacterIndex)
+	{
+		const bool bClimber = CharacterIndex < NumClimbers;
+
+		// Climbers start in front of a wall facing it, spread across the walls. Everyone else, and climbers in a loaded map, start anywhere.
+		FTransform Start(FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), FVector(Random.FRandRange(-0.5f, 0.5f) * FieldSize, Random.FRandRange(-0.5f, 0.5f) * FieldSize, 100.f));
+		if (bClimber && !ClimbStarts.IsEmpty())
+			Start = ClimbStarts[CharacterIndex % ClimbStarts.Num()];
+
+		AZCClimbingCharacter* Character = World->SpawnActor<AZCClimbingCharacter>(CharacterClass, Start, SpawnParams);
+		if (!Character)
+			continue;
+
+		Character->SpawnDefaultController();
+		if (Character->GetController())
+			Character->GetController()->SetControlRotation(Start.Rotator());
+
+		Characters.Add({ Character, bClimber, Random.FRandRange(0.f, 2.f * PI) });
+	}
+
+	UE_LOG(LogZCClimbing, Display, TEXT("Climb benchmark: %s, %d characters (%d climbers), %d frames"),
+		MapName.IsEmpty() ? TEXT("generated map") : *MapName, Characters.Num(), NumClimbers, NumFrames);
+
+	TArray<FString> Rows;
+	Rows.Reserve(NumFrames + 1);
+	Rows.Add(TEXT("Frame,GameThreadMs,ClimbingMs,WallSweepMs,SurfaceInfoMs,Sweeps,LineTraces,Overlaps,Hits,QueryCacheHits,Climbing,UsedPhysicalMB,UsedVirtualMB"));
+
+	TArray<double> FrameMilliseconds;
+	FrameMilliseconds.Reserve(NumFrames);
+
+	const float DeltaTime = 1.f / 60.f;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const float Time = Frame * DeltaTime;
+		for (const FBenchmarkCharacter& BenchmarkCharacter : Characters)
+			DriveCharacter(BenchmarkCharacter, Frame, Time);
+
+		// Query caches and async results are keyed on the frame counter
+		++GFrameCounter;
+
+		const double StartTime = FPlatformTime::Seconds();
+		World->Tick(LEVELTICK_All, DeltaTime);
+		const double GameThreadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		FrameMilliseconds.Add(GameThreadMs);
+
+		FZCClimbingProfile FrameProfile;
+		int32 NumClimbing = 0;
+		for (const FBenchmarkCharacter& BenchmarkCharacter : Characters)
+		{
+			UZCCharacterMovementComponent* Movement = BenchmarkCharacter.Character->GetZCMovementComponent();
+			if (!Movement)
+				continue;
+
+			FrameProfile.Accumulate(Movement->GetClimbingProfile());
+			Movement->ResetClimbingProfile();
+			if (Movement->IsClimbing())
+				++NumClimbing;
+		}
+
+		// Wall sweeps run outside PhysClimbing, every other stage inside it
+		const double ClimbingMs = FrameProfile.GetStageMilliseconds(EZCClimbStage::PhysClimbing) + FrameProfile.GetStageMilliseconds(EZCClimbStage::WallSweep);
+		const FPlatformMemoryStats Memory = FPlatformMemory::GetStats();
+
+		Rows.Add(FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d,%d,%d,%.1f,%.1f"), Frame, GameThreadMs, ClimbingMs,
+			FrameProfile.GetStageMilliseconds(EZCClimbStage::WallSweep), FrameProfile.GetStageMilliseconds(EZCClimbStage::SurfaceInfo),
+			FrameProfile.Sweeps, FrameProfile.LineTraces, FrameProfile.Overlaps, FrameProfile.HitsReturned, FrameProfile.QueryCacheHits, NumClimbing,
+			Memory.UsedPhysical / (1024.0 * 1024.0), Memory.UsedVirtual / (1024.0 * 1024.0)));
+	}
+
+	const bool bSaved = FFileHelper::SaveStringArrayToFile(Rows, *OutputPath);
+	if (!bSaved)
+		UE_LOG(LogZCClimbing, Error, TEXT("Couldn't write %s"), *OutputPath);
+
+	FrameMilliseconds.Sort();
+	double TotalMilliseconds = 0.0;
+	for (const double Milliseconds : FrameMilliseconds)
+		TotalMilliseconds += Milliseconds;
+
+	UE_LOG(LogZCClimbing, Display, TEXT("Climb benchmark: avg %.3f ms, median %.3f ms, p95 %.3f ms, max %.3f ms per frame, results written to %s"),
+		TotalMilliseconds / FrameMilliseconds.Num(),
+		FrameMilliseconds[FrameMilliseconds.Num() / 2],
+		FrameMilliseconds[FMath::Min(FrameMilliseconds.Num() - 1, FrameMilliseconds.Num() * 95 / 100)],
+		FrameMilliseconds.Last(), *OutputPath);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bSaved ? 0 : 1;
+}
+
+UWorld* UZCClimbBenchmarkCommandlet::CreateBenchmarkWorld(const FString& MapName) const
+{
+	UWorld* World = nullptr;
+	if (MapName.IsEmpty())
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ZCClimbBenchmark"));
+	}
+	else
+	{
+		UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+		World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogZCClimbing, Error, TEXT("Couldn't load map %s"), *MapName);
+			return nullptr;
+		}
+
+		World->WorldType = EWorldType::Game;
+		if (!World->bIsWorldInitialized)
+		{
+			UWorld::InitializationValues InitValues;
+			InitValues.RequiresHitProxies(false).ShouldSimulatePhysics(true).EnableTraceCollision(true).CreateNavigation(true).CreateAISystem(true).AllowAudioPlayback(false).CreatePhysicsScene(true);
+			World->InitWorld(InitValues);
+		}
+		World->UpdateWorldComponents(true, false);
+	}
+
+	World->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->InitializeActorsForPlay(URL);
+
+	return World;
+}
+
+void UZCClimbBenchmarkCommandlet::GenerateLegacyWalls(UWorld* World, float FieldSize, int32 NumWalls, FRandomStream& Random, TArray<FTransform>& OutClimbStarts) const
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh)
+		return;
+
+	// Deferred so the mesh goes on before the component registers as static
+	auto SpawnCube = [World, CubeMesh](const FTransform& Transform)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.bDeferConstruction = true;
+		AStaticMeshActor* Cube = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParams);
+		Cube->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Cube->FinishSpawning(Transform);
+	};
+
+	// The cube mesh is 100 units across and centred on its origin. Ground top is at 0.
+	SpawnCube(FTransform(FRotator::ZeroRotator, FVector(0.f, 0.f, -50.f), FVector(FieldSize / 100.f, FieldSize / 100.f, 1.f)));
+
+	// Draws from the same stream as the character placement, in the same order as before, so the whole run matches
+	for (int32 Wall = 0; Wall < NumWalls; ++Wall)
+	{
+		const FRotator Rotation(0.f, Random.FRandRange(0.f, 360.f), 0.f);
+		const FVector Size(50.f, Random.FRandRange(400.f, 800.f), Random.FRandRange(300.f, 600.f));
+		const FVector Location(Random.FRandRange(-0.45f, 0.45f) * FieldSize, Random.FRandRange(-0.45f, 0.45f) * FieldSize, Size.Z * 0.5f);
+		SpawnCube(FTransform(Rotation, Location, Size / 100.f));
+
+		// In front of the wall's -X face, looking at it
+		const FVector Forward = Rotation.Vector();
+		OutClimbStarts.Add(FTransform(Rotation, Location - Forward * (Size.X * 0.5f + 60.f) + FVector(0.f, 0.f, 100.f - Size.Z * 0.5f)));
+	}
+}
+
+void UZCClimbBenchmarkCommandlet::DriveCharacter(const FBenchmarkCharacter& BenchmarkCharacter, int32 Frame, float Time) const
+{
+	AZCClimbingCharacter* Character = BenchmarkCharacter.Character;
+	const UZCCharacterMovementComponent* Movement = Character->GetZCMovementComponent();
+	if (!Movement)
+		return;
+
+	const float Phase = BenchmarkCharacter.Phase;
+
+	if (!BenchmarkCharacter.bClimber)
+	{
+		// Wander in slow curves
+		if (AController* Controller = Character->GetController())
+			Controller->SetControlRotation(FRotator(0.f, FMath::RadiansToDegrees(Phase) + Time * 20.f, 0.f));
+		Character->Move(FInputActionValue(FVector2D(FMath::Sin(Time * 0.5f + Phase) * 0.5f, 1.f)));
+		return;
+	}
+
+	if (Movement->IsClimbing())
+	{
+		// Up, down and across the wall, with the odd dash
+		Character->Move(FInputActionValue(FVector2D(FMath::Sin(Time * 0.7f + Phase), FMath::Cos(Time * 0.4f + Phase))));
+		if ((Frame + FMath::RoundToInt(Phase * 100.f)) % 240 == 0)
+			Character->ClimbDash(FInputActionValue(true));
+	}
+	else
+	{
+		// Walk at whatever is ahead and keep trying to grab it
+		Character->Move(FInputActionValue(FVector2D(0.f, 1.f)));
+		if (Frame % 30 == 0)
+			Character->Climb(FInputActionValue(true));
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ZCClimbBenchmarkCommandlet.generated.h"
+
+class AZCClimbingCharacter;
+
+/**
+ * Headless climbing stress test. Loads a map, or generates an AZCClimbTerrain, spawns climbing characters driven by scripted input,
+ * simulates a fixed number of frames at a fixed step and writes per frame timings, scene query counts and memory to CSV.
+ * Usage: UnrealEditor-Cmd <Project> -run=ZCClimbBenchmark -nullrhi [-Map=/Game/Maps/Map] [-Characters=100] [-Frames=1800]
+ *        [-WallDensity=4] [-WallTilt=0] [-Overhangs=0] [-Ledges=0] [-Stairs=0] [-Patches=0] [-LegacyWalls] [-ClimbFraction=0.5] [-Seed=1] [-CharacterClass=/Game/ZC/Blueprints/BP_ZCCharacter.BP_ZCCharacter_C] [-Output=<File>.csv]
+ * WallDensity is walls per 10m x 10m of generated ground, the other terrain counts are totals, ClimbFraction the share of characters sent at a wall rather than walking around.
+ * The generated terrain's walls aren't laid out like the benchmark's original ones. -LegacyWalls spawns those instead, one static mesh actor each,
+ * so results stay comparable with runs from before AZCClimbTerrain. It ignores the other terrain options.
+ */
+UCLASS()
+class CLIMBING_API UZCClimbBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UZCClimbBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FBenchmarkCharacter
+	{
+		AZCClimbingCharacter* Character = nullptr;
+		bool bClimber = false;
+		float Phase = 0.f;
+	};
+
+	UWorld* CreateBenchmarkWorld(const FString& MapName) const;
+	void GenerateLegacyWalls(UWorld* World, float FieldSize, int32 NumWalls, FRandomStream& Random, TArray<FTransform>& OutClimbStarts) const;
+	void DriveCharacter(const FBenchmarkCharacter& BenchmarkCharacter, int32 Frame, float Time) const;
+};
@@ -0,0 +1,92 @@
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCClimbTerrain.h"
+#include "Climbing/Climbing.h"
+
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Math/RandomStream.h"
+
+// Times the climbing wall sweep against a wall buried in NoClimb props, once on ECC_WorldStatic like it used to and once on the
+// climbable channel, so the cost of the props the channel filters out can be measured
+static FAutoConsoleCommandWithWorldAndArgs ClimbChannelBenchmarkCommand(
+	TEXT("ZC.ClimbChannel.Benchmark"),
+	TEXT("Times climbing wall sweeps through a dense field of NoClimb props on WorldStatic and on the Climbable channel\n")
+	TEXT("Usage: ZC.ClimbChannel.Benchmark [NumProps=4000] [NumQueries=2000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (!World || !CubeMesh)
+			return;
+
+		const int32 NumProps = Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 4000;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 2000;
+
+		const FVector2D WallExtent(2000.f, 1000.f);
+		FVector WallFace;
+		AZCClimbTerrain* Wall = AZCClimbTerrain::SpawnBenchmarkWall(World, WallExtent * 2.f, WallFace);
+		if (!Wall)
+			return;
+
+		TArray<AActor*> Spawned = { Wall };
+
+		// Clutter on and in front of the wall, where the sweeps run: vines, pipes, crates, foliage
+		FRandomStream Random(0x5A17C);
+		for (int32 Prop = 0; Prop < NumProps; ++Prop)
+		{
+			const FVector Location = WallFace + FVector(-Random.FRandRange(0.f, 150.f), Random.FRandRange(-WallExtent.X, WallExtent.X), Random.FRandRange(-WallExtent.Y, WallExtent.Y));
+			const FRotator Rotation(Random.FRandRange(0.f, 360.f), Random.FRandRange(0.f, 360.f), 0.f);
+
+			AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>(Location, Rotation);
+			Prop->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			Prop->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+			Prop->GetStaticMeshComponent()->SetCollisionProfileName(TEXT("NoClimb"));
+			Prop->SetActorScale3D(FVector(Random.FRandRange(0.05f, 0.4f)));
+			Spawned.Add(Prop);
+		}
+
+		// Same shape and reach as the movement component's default wall sweep
+		const FCollisionShape Shape = FCollisionShape::MakeCapsule(50.f, 72.f);
+		const FVector Reach(20.f, 0.f, 0.f);
+
+		TArray<FVector> Starts;
+		Starts.Reserve(NumQueries);
+		for (int32 Query = 0; Query < NumQueries; ++Query)
+			Starts.Add(WallFace + FVector(-60.f, Random.FRandRange(-WallExtent.X * 0.9f, WallExtent.X * 0.9f), Random.FRandRange(-WallExtent.Y * 0.9f, WallExtent.Y * 0.9f)));
+
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(ZCClimbChannelBenchmark), false);
+		const ECollisionChannel ClimbChannel = UZCClimbingSettings::GetClimbTraceChannel();
+
+		auto TimeSweeps = [&](ECollisionChannel Channel, int32& OutNumHits)
+		{
+			TArray<FHitResult> Hits;
+			OutNumHits = 0;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (const FVector& Start : Starts)
+			{
+				World->SweepMultiByChannel(Hits, Start, Start + Reach, FQuat::Identity, Channel, Shape, Params);
+				OutNumHits += Hits.Num();
+			}
+			return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		};
+
+		// One untimed pass each so both start from the same warm caches
+		int32 NumHits = 0;
+		TimeSweeps(ECC_WorldStatic, NumHits);
+		TimeSweeps(ClimbChannel, NumHits);
+
+		int32 WorldStaticHits = 0;
+		int32 ClimbableHits = 0;
+		const double WorldStaticMs = TimeSweeps(ECC_WorldStatic, WorldStaticHits);
+		const double ClimbableMs = TimeSweeps(ClimbChannel, ClimbableHits);
+
+		UE_LOG(LogZCClimbing, Display, TEXT("ZC.ClimbChannel.Benchmark: %d props, %d sweeps"), NumProps, NumQueries);
+		UE_LOG(LogZCClimbing, Display, TEXT("    WorldStatic: %.3f ms total, %.4f ms/sweep, %.2f hits/sweep"), WorldStaticMs, WorldStaticMs / NumQueries, static_cast<float>(WorldStaticHits) / NumQueries);
+		UE_LOG(LogZCClimbing, Display, TEXT("    Climbable:   %.3f ms total, %.4f ms/sweep, %.2f hits/sweep, %.2fx"), ClimbableMs, ClimbableMs / NumQueries, static_cast<float>(ClimbableHits) / NumQueries,
+			ClimbableMs > 0.0 ? WorldStaticMs / ClimbableMs : 0.0);
+
+		for (AActor* Actor : Spawned)
+			Actor->Destroy();
+	}));
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+
+class UPrimitiveComponent;
+
+// The part of a wall hit the climbing checks use
+struct FZCClimbContact
+{
+	FVector ImpactPoint = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	int32 FaceIndex = INDEX_NONE;
+
+	UPrimitiveComponent* GetComponent() const { return Component.Get(); }
+};
+
+/**
+ * The wall contacts from the climbing sweep. Storage is inline and fixed size, so keeping it up to date every tick never allocates.
+ * A sweep returns its hits nearest first, past MaxContacts the furthest ones are dropped.
+ */
+struct FZCClimbContactManifold
+{
+	static constexpr int32 MaxContacts = 16;
+
+	// Replaces the contacts with the hits of a sweep. Returns the number of hits that didn't fit.
+	int32 Fill(const TArray<FHitResult>& Hits)
+	{
+		Contacts.Reset();
+
+		const int32 NumKept = FMath::Min(Hits.Num(), MaxContacts);
+		for (int32 HitIndex = 0; HitIndex < NumKept; ++HitIndex)
+		{
+			const FHitResult& Hit = Hits[HitIndex];
+			FZCClimbContact& Contact = Contacts.AddDefaulted_GetRef();
+			Contact.ImpactPoint = Hit.ImpactPoint;
+			Contact.Normal = Hit.Normal;
+			Contact.Component = Hit.Component;
+			Contact.FaceIndex = Hit.FaceIndex;
+		}
+
+		return Hits.Num() - NumKept;
+	}
+
+	void Reset() { Contacts.Reset(); }
+	int32 Num() const { return Contacts.Num(); }
+	bool IsEmpty() const { return Contacts.IsEmpty(); }
+
+	const FZCClimbContact& operator[](int32 Index) const { return Contacts[Index]; }
+	FZCClimbContact& operator[](int32 Index) { return Contacts[Index]; }
+
+	auto begin() const { return Contacts.begin(); }
+	auto end() const { return Contacts.end(); }
+
+private:
+	TArray<FZCClimbContact, TFixedAllocator<MaxContacts>> Contacts;
+};
@@ -0,0 +1,166 @@
+#include "Climbing/ZC/ZCClimbContactTracker.h"
+
+#include "Components/PrimitiveComponent.h"
+
+bool FZCClimbContactTracker::Capture(const FZCClimbContactManifold& WallContacts, const FVector& Normal, const FVector& Position, const FTransform& CharacterTransform, float FlatnessCos)
+{
+	Reset();
+
+	if (WallContacts.IsEmpty() || Normal.IsNearlyZero())
+		return false;
+
+	const UPrimitiveComponent* HitComponent = WallContacts[0].GetComponent();
+	if (!HitComponent)
+		return false;
+
+	for (const FZCClimbContact& Contact : WallContacts)
+		if (Contact.GetComponent() != HitComponent || (Contact.Normal | Normal) < FlatnessCos)
+			return false;
+
+	const FTransform WallTransform = HitComponent->GetComponentTransform();
+
+	LocalNormal = WallTransform.InverseTransformVectorNoScale(Normal);
+	LocalPosition = WallTransform.InverseTransformPositionNoScale(Position);
+	LocalCharacterLocation = WallTransform.InverseTransformPositionNoScale(CharacterTransform.GetLocation());
+	LocalCharacterForward = WallTransform.InverseTransformVectorNoScale(CharacterTransform.GetUnitAxis(EAxis::X));
+
+	Contacts = WallContacts;
+	for (const FZCClimbContact& Contact : WallContacts)
+	{
+		LocalImpactPoints.Add(WallTransform.InverseTransformPositionNoScale(Contact.ImpactPoint));
+		LocalNormals.Add(WallTransform.InverseTransformVectorNoScale(Contact.Normal));
+	}
+
+	Wall = HitComponent;
+	return true;
+}
+
+void FZCClimbContactTracker::Reset()
+{
+	Wall.Reset();
+	Contacts.Reset();
+	LocalImpactPoints.Reset();
+	LocalNormals.Reset();
+	bHasFloor = false;
+	bHasEyeHeightCheck = false;
+}
+
+bool FZCClimbContactTracker::GetCharacterLocal(const FTransform& CharacterTransform, FTransform& OutWallTransform, FVector& OutOffset) const
+{
+	const UPrimitiveComponent* WallComponent = Wall.Get();
+	if (!WallComponent)
+		return false;
+
+	OutWallTransform = WallComponent->GetComponentTransform();
+
+	// Only movement along the wall carries the contacts, the surface itself doesn't come closer or go further away
+	const FVector Offset = OutWallTransform.InverseTransformPositionNoScale(CharacterTransform.GetLocation()) - LocalCharacterLocation;
+	OutOffset = FVector::VectorPlaneProject(Offset, LocalNormal);
+	return true;
+}
+
+bool FZCClimbContactTracker::NeedsReprobe(const FTransform& CharacterTransform, float MaxDistance, float MaxAngleCos) const
+{
+	const UPrimitiveComponent* WallComponent = Wall.Get();
+	if (!WallComponent)
+		return true;
+
+	const FTransform WallTransform = WallComponent->GetComponentTransform();
+	const FVector LocalLocation = WallTransform.InverseTransformPositionNoScale(CharacterTransform.GetLocation());
+	const FVector LocalForward = WallTransform.InverseTransformVectorNoScale(CharacterTransform.GetUnitAxis(EAxis::X));
+
+	return FVector::DistSquared(LocalLocation, LocalCharacterLocation) > FMath::Square(MaxDistance) || (LocalForward | LocalCharacterForward) < MaxAngleCos;
+}
+
+bool FZCClimbContactTracker::ReprojectSurface(const FTransform& CharacterTransform, FVector& OutNormal, FVector& OutPosition) const
+{
+	FTransform WallTransform;
+	FVector Offset;
+	if (!GetCharacterLocal(CharacterTransform, WallTransform, Offset))
+		return false;
+
+	OutNormal = WallTransform.TransformVectorNoScale(LocalNormal);
+	OutPosition = WallTransform.TransformPositionNoScale(LocalPosition + Offset);
+	return true;
+}
+
+bool FZCClimbContactTracker::ReprojectContacts(const FTransform& CharacterTransform, FZCClimbContactManifold& OutWallContacts) const
+{
+	FTransform WallTransform;
+	FVector Offset;
+	if (!GetCharacterLocal(CharacterTransform, WallTransform, Offset))
+		return false;
+
+	OutWallContacts = Contacts;
+	for (int32 ContactIndex = 0; ContactIndex < Contacts.Num(); ++ContactIndex)
+	{
+		FZCClimbContact& Contact = OutWallContacts[ContactIndex];
+		Contact.ImpactPoint = WallTransform.TransformPositionNoScale(LocalImpactPoints[ContactIndex] + Offset);
+		Contact.Normal = WallTransform.TransformVectorNoScale(LocalNormals[ContactIndex]);
+	}
+
+	return true;
+}
+
+bool FZCClimbContactTracker::Agrees(const FHitResult& Hit, const FVector& Normal, float ExpectedDistance, float MaxDistanceError, float MaxAngleCos) const
+{
+	return Hit.bBlockingHit && Hit.GetComponent() == Wall.Get() && (Hit.ImpactNormal | Normal) >= MaxAngleCos && FMath::Abs(Hit.Distance - ExpectedDistance) <= MaxDistanceError;
+}
+
+void FZCClimbContactTracker::KeepFloor(const FHitResult& Hit, const FVector& TraceEnd)
+{
+	const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+	if (!IsTracking() || (Hit.bBlockingHit && (!HitComponent || HitComponent->Mobility != EComponentMobility::Static)))
+		return;
+
+	bHasFloor = true;
+	FloorHit = Hit;
+	FloorTraceEnd = TraceEnd;
+}
+
+bool FZCClimbContactTracker::FindFloor(const FVector& Location, float CheckDistance, FHitResult& OutHit, bool& bOutFound) const
+{
+	if (!bHasFloor)
+		return false;
+
+	// Nothing down to where the trace ended, which answers as long as the check doesn't reach any lower
+	if (!FloorHit.bBlockingHit)
+	{
+		if (Location.Z - CheckDistance < FloorTraceEnd.Z)
+			return false;
+
+		bOutFound = false;
+		return true;
+	}
+
+	// Climbed down past the floor that was found, so something else is under the character now
+	const float Distance = Location.Z - FloorHit.ImpactPoint.Z;
+	if (Distance < 0.f)
+		return false;
+
+	OutHit = FloorHit;
+	OutHit.Distance = Distance;
+	bOutFound = Distance <= CheckDistance;
+	return true;
+}
+
+void FZCClimbContactTracker::KeepEyeHeightCheck(bool bHitWall, const FVector& RaisedEyeLocation)
+{
+	const UPrimitiveComponent* WallComponent = Wall.Get();
+	if (!WallComponent)
+		return;
+
+	bHasEyeHeightCheck = true;
+	bEyeHeightCheckHitWall = bHitWall;
+	LocalRaisedEyeLocation = WallComponent->GetComponentTransform().InverseTransformPositionNoScale(RaisedEyeLocation);
+}
+
+bool FZCClimbContactTracker::IsWallAboveEyes(const FVector& EyeLocation, const FVector& Up) const
+{
+	const UPrimitiveComponent* WallComponent = Wall.Get();
+	if (!bHasEyeHeightCheck || !bEyeHeightCheckHitWall || !WallComponent)
+		return false;
+
+	const FVector RaisedEyeLocation = WallComponent->GetComponentTransform().TransformPositionNoScale(LocalRaisedEyeLocation);
+	return ((RaisedEyeLocation - EyeLocation) | Up) >= 0.f;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+#include "Climbing/ZC/ZCClimbContactManifold.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Wall contacts and surface info from the last full probe, kept in the wall's local frame. While the character stays close to where
+ * they were captured, they can be carried along with it instead of re-probed: contact points slide with the character across the
+ * plane of the wall and follow the wall if it moves. Only tracks contact with a single flat surface, anything else needs full probes.
+ */
+struct FZCClimbContactTracker
+{
+	// Starts tracking from a full probe. Returns false, and stops tracking, if the contacts aren't all on one flat surface.
+	bool Capture(const FZCClimbContactManifold& WallContacts, const FVector& Normal, const FVector& Position, const FTransform& CharacterTransform, float FlatnessCos);
+	void Reset();
+
+	bool IsTracking() const { return Wall.IsValid(); }
+
+	// Whether the character has moved or turned too far from where the contacts were captured to trust them
+	bool NeedsReprobe(const FTransform& CharacterTransform, float MaxDistance, float MaxAngleCos) const;
+
+	// Surface normal and position carried along to the character's current transform
+	bool ReprojectSurface(const FTransform& CharacterTransform, FVector& OutNormal, FVector& OutPosition) const;
+	// Captured wall contacts carried along to the character's current transform
+	bool ReprojectContacts(const FTransform& CharacterTransform, FZCClimbContactManifold& OutWallContacts) const;
+
+	// Whether a ray straight at the wall hit where the reprojected surface says it should
+	bool Agrees(const FHitResult& Hit, const FVector& Normal, float ExpectedDistance, float MaxDistanceError, float MaxAngleCos) const;
+
+	// The floor check's last trace, kept until the next capture. Traced further down than the check needs, so it keeps answering
+	// as the character climbs about. Only a static floor is kept, anything else may have moved by the next check.
+	void KeepFloor(const FHitResult& Hit, const FVector& TraceEnd);
+	// Answers a floor check CheckDistance down from Location with the kept trace. Returns false if that doesn't cover it.
+	bool FindFloor(const FVector& Location, float CheckDistance, FHitResult& OutHit, bool& bOutFound) const;
+
+	// An eye height trace from RaisedEyeLocation, higher up the wall than the eyes, kept until the next capture
+	void KeepEyeHeightCheck(bool bHitWall, const FVector& RaisedEyeLocation);
+	bool HasEyeHeightCheck() const { return bHasEyeHeightCheck; }
+	// Whether the kept eye height check hit the wall and the eyes haven't climbed up past where it was traced from
+	bool IsWallAboveEyes(const FVector& EyeLocation, const FVector& Up) const;
+
+private:
+	bool GetCharacterLocal(const FTransform& CharacterTransform, FTransform& OutWallTransform, FVector& OutOffset) const;
+
+	TWeakObjectPtr<const UPrimitiveComponent> Wall;
+
+	FVector LocalNormal = FVector::ZeroVector;
+	FVector LocalPosition = FVector::ZeroVector;
+	FVector LocalCharacterLocation = FVector::ZeroVector;
+	FVector LocalCharacterForward = FVector::ZeroVector;
+
+	FZCClimbContactManifold Contacts;
+	TArray<FVector, TFixedAllocator<FZCClimbContactManifold::MaxContacts>> LocalImpactPoints;
+	TArray<FVector, TFixedAllocator<FZCClimbContactManifold::MaxContacts>> LocalNormals;
+
+	bool bHasFloor = false;
+	FHitResult FloorHit;
+	FVector FloorTraceEnd = FVector::ZeroVector;
+
+	bool bHasEyeHeightCheck = false;
+	bool bEyeHeightCheckHitWall = false;
+	FVector LocalRaisedEyeLocation = FVector::ZeroVector;
+};
@@ -0,0 +1,133 @@
+#include "Climbing/ZC/ZCClimbGrid.h"
+#include "Climbing/ZC/ZCClimbProxy.h"
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCTypes.h"
+
+#include "Components/BoxComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+FZCClimbGridCell::FZCClimbGridCell(const FVector& Normal, EZCClimbCellFlags InFlags)
+	: NormalX(static_cast<int8>(FMath::RoundToInt(Normal.X * 127.f)))
+	, NormalY(static_cast<int8>(FMath::RoundToInt(Normal.Y * 127.f)))
+	, NormalZ(static_cast<int8>(FMath::RoundToInt(Normal.Z * 127.f)))
+	, Flags(static_cast<uint8>(InFlags))
+{
+}
+
+AZCClimbGrid::AZCClimbGrid()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BakeBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("BakeBounds"));
+	BakeBounds->SetBoxExtent(FVector(2000.f));
+	BakeBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RootComponent = BakeBounds;
+}
+
+FIntVector AZCClimbGrid::ToCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+FVector AZCClimbGrid::GetCellCenter(const FIntVector& Cell) const
+{
+	return (FVector(Cell) + FVector(0.5f)) * CellSize;
+}
+
+void AZCClimbGrid::Bake()
+{
+	Modify();
+
+	Cells.Reset();
+	BakedBounds = BakeBounds->Bounds.GetBox();
+
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	// Climbing queries see the climb proxies rather than the meshes they stand in for, so the bake has to as well
+	const FZCClimbProxyBakeScope ClimbProxies(World);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ZCClimbGridBake), false, this);
+	const ECollisionChannel ClimbChannel = UZCClimbingSettings::GetClimbTraceChannel();
+	const FIntVector MinCell = ToCell(BakedBounds.Min);
+	const FIntVector MaxCell = ToCell(BakedBounds.Max);
+
+	// Mark every cell that static geometry passes through
+	TSet<FIntVector> SolidCells;
+	const FCollisionShape CellShape = FCollisionShape::MakeBox(FVector(CellSize * 0.5f));
+	for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				const FIntVector Cell(X, Y, Z);
+				if (IsStaticGeometryAt(GetCellCenter(Cell), CellShape, Params))
+					SolidCells.Add(Cell);
+			}
+
+	const FIntVector HorizontalNeighbours[] = { FIntVector(1, 0, 0), FIntVector(-1, 0, 0), FIntVector(0, 1, 0), FIntVector(0, -1, 0) };
+	const float MinVerticalAngleCos = FMath::Cos(FMath::DegreesToRadians(MinVerticalDegreesToStartClimbing));
+	const float WalkableFloorZ = GetDefault<UCharacterMovementComponent>()->GetWalkableFloorZ();
+
+	for (const FIntVector& Cell : SolidCells)
+	{
+		// Only cells with open space next to them have a surface the character could be facing. Trace in from each open side to find it.
+		FVector NormalSum = FVector::ZeroVector;
+		for (const FIntVector& Direction : HorizontalNeighbours)
+		{
+			const FIntVector Neighbour = Cell + Direction;
+			if (SolidCells.Contains(Neighbour))
+				continue;
+
+			const FVector Start = GetCellCenter(Neighbour);
+			const FVector End = Start - FVector(Direction) * CellSize * 1.5f;
+
+			FHitResult SurfaceHit;
+			if (World->LineTraceSingleByChannel(SurfaceHit, Start, End, ClimbChannel, Params))
+				NormalSum += SurfaceHit.ImpactNormal;
+		}
+
+		if (NormalSum.IsNearlyZero())
+			continue;
+
+		const FVector Normal = NormalSum.GetSafeNormal();
+		const FVector HorizontalNormal = Normal.GetSafeNormal2D();
+		const float VerticalAngleCos = FVector::DotProduct(Normal, HorizontalNormal);
+
+		EZCClimbCellFlags Flags = EZCClimbCellFlags::None;
+		if (!FMath::IsNearlyZero(VerticalAngleCos) && VerticalAngleCos >= MinVerticalAngleCos)
+			Flags |= EZCClimbCellFlags::Climbable;
+
+		// A ledge is open space above with a walkable top just inside the surface
+		if (!SolidCells.Contains(Cell + FIntVector(0, 0, 1)))
+		{
+			const FVector TopCheck = GetCellCenter(Cell) - HorizontalNormal * CellSize * 0.25f;
+			const FVector Start = TopCheck + FVector::UpVector * CellSize;
+			const FVector End = TopCheck - FVector::UpVector * CellSize * 0.5f;
+
+			FHitResult TopHit;
+			if (World->LineTraceSingleByChannel(TopHit, Start, End, ClimbChannel, Params) && TopHit.ImpactNormal.Z >= WalkableFloorZ)
+				Flags |= EZCClimbCellFlags::LedgeAbove;
+		}
+
+		Cells.Add(Cell, FZCClimbGridCell(Normal, Flags));
+	}
+}
+
+bool AZCClimbGrid::IsStaticGeometryAt(const FVector& Location, const FCollisionShape& Shape, const FCollisionQueryParams& Params) const
+{
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, UZCClimbingSettings::GetClimbTraceChannel(), Shape, Params);
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const UPrimitiveComponent* OverlapComponent = Overlap.GetComponent();
+		if (Overlap.bBlockingHit && OverlapComponent && OverlapComponent->Mobility == EComponentMobility::Static)
+			return true;
+	}
+
+	return false;
+}
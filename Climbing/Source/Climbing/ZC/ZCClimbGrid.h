@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ZCClimbGrid.generated.h"
+
+enum class EZCClimbCellFlags : uint8
+{
+	None			= 0,
+	Climbable		= 1 << 0,	// steep enough to climb
+	LedgeAbove		= 1 << 1,	// the surface ends in a walkable top right above this cell. Baked for tools, ledge climbs are answered by AZCLedgeGraph.
+};
+ENUM_CLASS_FLAGS(EZCClimbCellFlags);
+
+/**
+ * One surface cell of the baked grid. Only cells on the outside of static geometry are stored.
+ */
+USTRUCT()
+struct FZCClimbGridCell
+{
+	GENERATED_BODY()
+
+	FZCClimbGridCell() {}
+	FZCClimbGridCell(const FVector& Normal, EZCClimbCellFlags InFlags);
+
+	FVector GetNormal() const { return FVector(NormalX, NormalY, NormalZ) / 127.f; }
+	bool IsClimbable() const { return EnumHasAnyFlags(static_cast<EZCClimbCellFlags>(Flags), EZCClimbCellFlags::Climbable); }
+	bool HasLedgeAbove() const { return EnumHasAnyFlags(static_cast<EZCClimbCellFlags>(Flags), EZCClimbCellFlags::LedgeAbove); }
+
+	// Surface normal quantized to a byte per axis
+	UPROPERTY()
+	int8 NormalX = 0;
+	UPROPERTY()
+	int8 NormalY = 0;
+	UPROPERTY()
+	int8 NormalZ = 0;
+
+	UPROPERTY()
+	uint8 Flags = 0;
+};
+
+/**
+ * Sparse voxelization of the static geometry inside its bounds, baked ahead of time so climb start checks can be
+ * answered from memory instead of scene queries. Anything that isn't static mobility is ignored and has to go through the live checks.
+ */
+UCLASS()
+class CLIMBING_API AZCClimbGrid : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AZCClimbGrid();
+
+	// Rebuilds the grid from whatever static geometry is inside BakeBounds, tracing climb proxies in place of their meshes. Rebake after regenerating proxies.
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Climbing")
+	void Bake();
+
+	bool Covers(const FVector& Location) const { return !Cells.IsEmpty() && BakedBounds.IsInsideOrOn(Location); }
+	const FZCClimbGridCell* FindCell(const FVector& Location) const { return Cells.Find(ToCell(Location)); }
+	float GetCellSize() const { return CellSize; }
+	int32 GetNumCells() const { return Cells.Num(); }
+
+	FIntVector ToCell(const FVector& Location) const;
+	FVector GetCellCenter(const FIntVector& Cell) const;
+
+protected:
+	UPROPERTY(Category = "Climbing", VisibleAnywhere)
+	class UBoxComponent* BakeBounds;
+
+	UPROPERTY(Category = "Climbing", EditAnywhere, meta = (ClampMin = "10.0", ClampMax = "200.0"))
+	float CellSize = 25.f;
+
+	// Should match the movement component's MinVerticalDegreesToStartClimbing
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float MinVerticalDegreesToStartClimbing = 45;
+
+	UPROPERTY()
+	FBox BakedBounds;
+
+	UPROPERTY()
+	TMap<FIntVector, FZCClimbGridCell> Cells;
+
+private:
+	bool IsStaticGeometryAt(const FVector& Location, const FCollisionShape& Shape, const FCollisionQueryParams& Params) const;
+};
@@ -0,0 +1,53 @@
+#include "Climbing/ZC/ZCClimbMotionProfile.h"
+
+#include "Curves/CurveFloat.h"
+
+void FZCCurveTable::Bake(const UCurveFloat& Curve, int32 Resolution)
+{
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	const float Duration = MaxTime - MinTime;
+	SamplesPerSecond = Duration > KINDA_SMALL_NUMBER ? Resolution / Duration : 0.f;
+	LastSample = Resolution;
+
+	Samples.SetNumUninitialized(Resolution + 2);
+	for (int32 Sample = 0; Sample <= Resolution; ++Sample)
+		Samples[Sample] = Curve.GetFloatValue(MinTime + Duration * Sample / Resolution);
+	Samples[Resolution + 1] = Samples[Resolution];
+}
+
+void FZCCurveTable::Reset()
+{
+	*this = FZCCurveTable();
+}
+
+void UZCClimbMotionProfile::ConditionalBakeTables()
+{
+	if (!bTablesBaked)
+		BakeTables();
+}
+
+#if WITH_EDITOR
+void UZCClimbMotionProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeTables();
+}
+#endif
+
+void UZCClimbMotionProfile::BakeTables()
+{
+	auto BakeTable = [this](FZCCurveTable& Table, const UCurveFloat* Curve)
+	{
+		if (Curve)
+			Table.Bake(*Curve, TableResolution);
+		else
+			Table.Reset();
+	};
+
+	BakeTable(DashTable, ClimbDashCurve);
+	BakeTable(RotationSpeedTable, RotationSpeedCurve);
+	BakeTable(SnapSpeedTable, SnapSpeedCurve);
+	bTablesBaked = true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ZCClimbMotionProfile.generated.h"
+
+class UCurveFloat;
+
+/**
+ * A curve sampled at a fixed resolution. Evaluating it is a clamp and a lerp between two samples with no branches or key searches,
+ * and gives the same result for the same input on every machine.
+ */
+struct CLIMBING_API FZCCurveTable
+{
+	void Bake(const UCurveFloat& Curve, int32 Resolution);
+	void Reset();
+
+	bool IsBaked() const { return Samples.Num() > 0; }
+	float GetMinTime() const { return MinTime; }
+	float GetMaxTime() const { return MaxTime; }
+
+	float Evaluate(float Time) const
+	{
+		// Samples has one extra copy of the last value on the end so Index + 1 is always valid
+		const float Position = FMath::Clamp((Time - MinTime) * SamplesPerSecond, 0.f, LastSample);
+		const int32 Index = static_cast<int32>(Position);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+	}
+
+private:
+	TArray<float> Samples;
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	float SamplesPerSecond = 0.f;
+	float LastSample = 0.f;
+};
+
+/**
+ * Climbing motion curves baked into lookup tables. One profile is shared by every character that uses it.
+ */
+UCLASS(BlueprintType)
+class CLIMBING_API UZCClimbMotionProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Bakes the tables if they haven't been yet. Game thread only.
+	void ConditionalBakeTables();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	bool HasDash() const { return DashTable.IsBaked(); }
+	float GetDashSpeed(float DashTime) const { return DashTable.Evaluate(DashTime); }
+	float GetDashEndTime() const { return DashTable.GetMaxTime(); }
+
+	bool HasRotationSpeed() const { return RotationSpeedTable.IsBaked(); }
+	float GetRotationSpeed(float SpeedRatio) const { return RotationSpeedTable.Evaluate(SpeedRatio); }
+
+	bool HasSnapSpeed() const { return SnapSpeedTable.IsBaked(); }
+	float GetSnapSpeed(float SpeedRatio) const { return SnapSpeedTable.Evaluate(SpeedRatio); }
+
+protected:
+	// Dash speed over the dash's duration
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	UCurveFloat* ClimbDashCurve;
+
+	// Rotation speed by how fast the character is climbing relative to MaxClimbingSpeed. Optional.
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	UCurveFloat* RotationSpeedCurve;
+
+	// Surface snap speed by how fast the character is climbing relative to MaxClimbingSpeed. Optional.
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	UCurveFloat* SnapSpeedCurve;
+
+	// Samples per table across each curve's time range
+	UPROPERTY(Category = "Climbing", EditAnywhere, meta = (ClampMin = "8", ClampMax = "1024"))
+	int32 TableResolution = 128;
+
+private:
+	void BakeTables();
+
+	FZCCurveTable DashTable;
+	FZCCurveTable RotationSpeedTable;
+	FZCCurveTable SnapSpeedTable;
+	bool bTablesBaked = false;
+};
@@ -0,0 +1,97 @@
+#include "Climbing/ZC/ZCClimbNavigation.h"
+#include "Climbing/ZC/ZCLedgeGraph.h"
+#include "Climbing/Climbing.h"
+
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "EngineUtils.h"
+
+UZCNavArea_Climb::UZCNavArea_Climb(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DefaultCost = 3.f;
+	DrawColor = FColor(255, 140, 0);
+}
+
+// Times path queries between random navigable points, so the cost of pathing over climb links can be tracked on big maps
+static FAutoConsoleCommandWithWorldAndArgs ClimbNavBenchmarkCommand(
+	TEXT("ZC.ClimbNav.Benchmark"),
+	TEXT("Times path queries between random points on the navmesh and reports how many of the paths climb\n")
+	TEXT("Usage: ZC.ClimbNav.Benchmark [NumQueries]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+		if (!NavData)
+		{
+			UE_LOG(LogZCClimbing, Warning, TEXT("ZC.ClimbNav.Benchmark: no navigation data"));
+			return;
+		}
+
+		const int32 NumQueries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+		TArray<const AZCLedgeGraph*> LedgeGraphs;
+		int32 NumClimbLinks = 0;
+		for (TActorIterator<AZCLedgeGraph> It(World); It; ++It)
+		{
+			LedgeGraphs.Add(*It);
+			NumClimbLinks += It->GetClimbLinks().Num();
+		}
+
+		TArray<double> QueryMilliseconds;
+		QueryMilliseconds.Reserve(NumQueries);
+		int32 NumFound = 0;
+		int32 NumClimbing = 0;
+
+		for (int32 Query = 0; Query < NumQueries; ++Query)
+		{
+			FNavLocation Start;
+			FNavLocation End;
+			if (!NavSys->GetRandomPoint(Start, NavData) || !NavSys->GetRandomPoint(End, NavData))
+				continue;
+
+			FPathFindingQuery PathQuery(nullptr, *NavData, Start.Location, End.Location);
+
+			const double StartTime = FPlatformTime::Seconds();
+			const FPathFindingResult Result = NavSys->FindPathSync(PathQuery);
+			QueryMilliseconds.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+			if (!Result.IsSuccessful() || !Result.Path.IsValid())
+				continue;
+
+			++NumFound;
+
+			// A path climbs if any of its segments runs along a climb link
+			const TArray<FNavPathPoint>& Points = Result.Path->GetPathPoints();
+			bool bClimbs = false;
+			for (int32 PointIndex = 0; PointIndex + 1 < Points.Num() && !bClimbs; ++PointIndex)
+				for (const AZCLedgeGraph* LedgeGraph : LedgeGraphs)
+					if (LedgeGraph->FindClimbLink(Points[PointIndex].Location, Points[PointIndex + 1].Location, 50.f))
+					{
+						bClimbs = true;
+						break;
+					}
+
+			if (bClimbs)
+				++NumClimbing;
+		}
+
+		if (QueryMilliseconds.IsEmpty())
+		{
+			UE_LOG(LogZCClimbing, Warning, TEXT("ZC.ClimbNav.Benchmark: couldn't find any navigable points"));
+			return;
+		}
+
+		QueryMilliseconds.Sort();
+		double TotalMilliseconds = 0.0;
+		for (const double Milliseconds : QueryMilliseconds)
+			TotalMilliseconds += Milliseconds;
+
+		UE_LOG(LogZCClimbing, Display, TEXT("ZC.ClimbNav.Benchmark: %d queries, %d climb links, %d paths found, %d climbing"),
+			QueryMilliseconds.Num(), NumClimbLinks, NumFound, NumClimbing);
+		UE_LOG(LogZCClimbing, Display, TEXT("    avg %.3f ms, median %.3f ms, p95 %.3f ms, max %.3f ms"),
+			TotalMilliseconds / QueryMilliseconds.Num(),
+			QueryMilliseconds[QueryMilliseconds.Num() / 2],
+			QueryMilliseconds[FMath::Min(QueryMilliseconds.Num() - 1, QueryMilliseconds.Num() * 95 / 100)],
+			QueryMilliseconds.Last());
+	}));
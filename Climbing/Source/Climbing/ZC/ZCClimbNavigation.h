@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavAreas/NavArea.h"
+#include "ZCClimbNavigation.generated.h"
+
+/**
+ * Nav area for the climb links baked by AZCLedgeGraph. Costs more than walking since climbing is slower.
+ */
+UCLASS(Config = Engine)
+class CLIMBING_API UZCNavArea_Climb : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	UZCNavArea_Climb(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,111 @@
+#include "Climbing/ZC/ZCClimbPathFollowingComponent.h"
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCLedgeGraph.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+
+#include "EngineUtils.h"
+#include "InputActionValue.h"
+
+void UZCClimbPathFollowingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (TActorIterator<AZCLedgeGraph> It(GetWorld()); It; ++It)
+		LedgeGraphs.Add(*It);
+}
+
+void UZCClimbPathFollowingComponent::OnPathFinished(const FPathFollowingResult& Result)
+{
+	ClearClimbLink();
+
+	Super::OnPathFinished(Result);
+}
+
+void UZCClimbPathFollowingComponent::SetMoveSegment(int32 SegmentStartIndex)
+{
+	Super::SetMoveSegment(SegmentStartIndex);
+
+	ClearClimbLink();
+
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	if (!PathPoints.IsValidIndex(MoveSegmentEndIndex))
+		return;
+
+	CurrentClimbLink = FindClimbLink(PathPoints[MoveSegmentStartIndex].Location, PathPoints[MoveSegmentEndIndex].Location);
+
+	// Climbing is slow enough to look like being blocked
+	if (CurrentClimbLink && bUseBlockDetection)
+	{
+		SetBlockDetectionState(false);
+		bRestoreBlockDetection = true;
+	}
+}
+
+void UZCClimbPathFollowingComponent::FollowPathSegment(float DeltaTime)
+{
+	AZCClimbingCharacter* Character = CurrentClimbLink && MovementComp ? Cast<AZCClimbingCharacter>(MovementComp->GetOwner()) : nullptr;
+	UZCCharacterMovementComponent* ClimbingMovement = Character ? Character->GetZCMovementComponent() : nullptr;
+	if (!ClimbingMovement)
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	if (ClimbingMovement->IsClimbing())
+	{
+		bStartedLinkClimb = true;
+
+		// Climb straight up, steering sideways back onto the link
+		const FVector SurfaceRight = FVector::CrossProduct(ClimbingMovement->GetClimbSurfaceNormal(), Character->GetActorUpVector());
+		const float Right = FMath::Clamp(FVector::DotProduct(CurrentClimbLink->Top - Character->GetActorLocation(), SurfaceRight) / ClimbLinkTolerance, -1.f, 1.f);
+		Character->Move(FInputActionValue(FVector2D(Right, 1.f)));
+		return;
+	}
+
+	// Past the ledge, walk the rest of the segment
+	if (bStartedLinkClimb)
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	const FVector ToBase = CurrentClimbLink->Base - Character->GetActorLocation();
+	if (ToBase.SizeSquared2D() > FMath::Square(ClimbStartDistance))
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	Character->SetActorRotation(FRotator(0.f, (-CurrentClimbLink->WallNormal).Rotation().Yaw, 0.f));
+	ClimbingMovement->WantsClimbing();
+
+	TimeWaitingToClimb += DeltaTime;
+	if (TimeWaitingToClimb > ClimbStartTimeout)
+		AbortMove(*this, FPathFollowingResultFlags::MovementStop);
+}
+
+const FZCClimbLink* UZCClimbPathFollowingComponent::FindClimbLink(const FVector& Start, const FVector& End) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZCClimbLinkLookup);
+
+	for (const AZCLedgeGraph* LedgeGraph : LedgeGraphs)
+		if (IsValid(LedgeGraph))
+			if (const FZCClimbLink* Link = LedgeGraph->FindClimbLink(Start, End, ClimbLinkTolerance))
+				return Link;
+
+	return nullptr;
+}
+
+void UZCClimbPathFollowingComponent::ClearClimbLink()
+{
+	CurrentClimbLink = nullptr;
+	bStartedLinkClimb = false;
+	TimeWaitingToClimb = 0.f;
+
+	if (bRestoreBlockDetection)
+	{
+		SetBlockDetectionState(true);
+		bRestoreBlockDetection = false;
+	}
+}
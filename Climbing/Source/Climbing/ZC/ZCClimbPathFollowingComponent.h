@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "ZCClimbPathFollowingComponent.generated.h"
+
+struct FZCClimbLink;
+
+/**
+ * Follows navmesh paths that include AZCLedgeGraph climb links. Walks the rest of the path as usual, and on a climb link
+ * faces the wall, starts climbing and drives the character's climbing input up to the ledge.
+ */
+UCLASS()
+class CLIMBING_API UZCClimbPathFollowingComponent : public UPathFollowingComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void BeginPlay() override;
+	virtual void OnPathFinished(const FPathFollowingResult& Result) override;
+
+	bool IsOnClimbLink() const { return CurrentClimbLink != nullptr; }
+
+protected:
+	virtual void SetMoveSegment(int32 SegmentStartIndex) override;
+	virtual void FollowPathSegment(float DeltaTime) override;
+
+	// How close to the base of a climb link the character has to be before it starts climbing
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float ClimbStartDistance = 80.f;
+	// Gives up on the move if climbing hasn't started this long after reaching the base
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float ClimbStartTimeout = 2.f;
+	// How far a path point can be from a climb link's ends and still be matched to it
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float ClimbLinkTolerance = 50.f;
+
+private:
+	const FZCClimbLink* FindClimbLink(const FVector& Start, const FVector& End) const;
+	void ClearClimbLink();
+
+	UPROPERTY(Transient)
+	TArray<class AZCLedgeGraph*> LedgeGraphs;
+
+	const FZCClimbLink* CurrentClimbLink = nullptr;
+	bool bStartedLinkClimb = false;
+	float TimeWaitingToClimb = 0.f;
+	bool bRestoreBlockDetection = false;
+};
@@ -0,0 +1,325 @@
+#include "Climbing/ZC/ZCClimbProxy.h"
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCTypes.h"
+#include "Climbing/Climbing.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/BoxComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshResources.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<bool> CVarClimbProxiesEnable(
+	TEXT("ZC.ClimbProxies.Enable"),
+	true,
+	TEXT("Makes climbing queries run against the climb proxies of meshes that have one. Read as each level is added."),
+	ECVF_Default);
+
+int32 UZCClimbProxyUserData::CountSourceCollisionTriangles(const UStaticMesh* Mesh)
+{
+	const UBodySetup* BodySetup = Mesh ? Mesh->GetBodySetup() : nullptr;
+	if (!BodySetup)
+		return 0;
+
+	// Complex as simple means queries trace the mesh's own triangles
+	if (BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple)
+	{
+		const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+		return RenderData && !RenderData->LODResources.IsEmpty() ? RenderData->LODResources[0].GetNumTriangles() : 0;
+	}
+
+	// Spheres and capsules are analytic and don't add any
+	int32 Triangles = BodySetup->AggGeom.BoxElems.Num() * 12;
+	for (const FKConvexElem& Convex : BodySetup->AggGeom.ConvexElems)
+		Triangles += Convex.IndexData.Num() / 3;
+
+	return Triangles;
+}
+
+#if WITH_EDITOR
+bool UZCClimbProxyUserData::Generate()
+{
+	UStaticMesh* Mesh = GetTypedOuter<UStaticMesh>();
+	const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+	if (!RenderData || RenderData->LODResources.IsEmpty())
+		return false;
+
+	const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+	const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+	const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+	if (Indices.Num() < 3 || Positions.GetNumVertices() == 0)
+		return false;
+
+	struct FTriangle
+	{
+		FVector Vertices[3];
+		FVector Normal;
+		FVector Centroid;
+		double Area;
+	};
+
+	TArray<FTriangle> Triangles;
+	Triangles.Reserve(Indices.Num() / 3);
+	double TotalArea = 0.0;
+
+	for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+	{
+		FTriangle Triangle;
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+			Triangle.Vertices[Corner] = FVector(Positions.VertexPosition(Indices[Index + Corner]));
+
+		// Same winding the mesh builder uses for face normals
+		const FVector Cross = (Triangle.Vertices[2] - Triangle.Vertices[0]) ^ (Triangle.Vertices[1] - Triangle.Vertices[0]);
+		Triangle.Area = Cross.Size() * 0.5;
+		if (Triangle.Area < UE_KINDA_SMALL_NUMBER)
+			continue;
+
+		Triangle.Normal = Cross.GetUnsafeNormal();
+		Triangle.Centroid = (Triangle.Vertices[0] + Triangle.Vertices[1] + Triangle.Vertices[2]) / 3.0;
+		TotalArea += Triangle.Area;
+		Triangles.Add(Triangle);
+	}
+
+	struct FRegion
+	{
+		FVector Normal;
+		double PlaneDistance;
+		FVector WeightedNormal = FVector::ZeroVector;
+		double Area = 0.0;
+		TArray<FVector> Vertices;
+	};
+
+	// Grow planar regions from the largest triangles down, so each region's plane is set by its biggest face
+	Triangles.Sort([](const FTriangle& A, const FTriangle& B) { return A.Area > B.Area; });
+
+	const double MinNormalCos = FMath::Cos(FMath::DegreesToRadians(PlanarAngleTolerance));
+	TArray<FRegion> Regions;
+	for (const FTriangle& Triangle : Triangles)
+	{
+		FRegion* Region = Regions.FindByPredicate([&](const FRegion& Candidate)
+		{
+			return (Candidate.Normal | Triangle.Normal) >= MinNormalCos && FMath::Abs((Triangle.Centroid | Candidate.Normal) - Candidate.PlaneDistance) <= PlanarDistanceTolerance;
+		});
+
+		if (!Region)
+		{
+			Region = &Regions.AddDefaulted_GetRef();
+			Region->Normal = Triangle.Normal;
+			Region->PlaneDistance = Triangle.Centroid | Triangle.Normal;
+		}
+
+		Region->WeightedNormal += Triangle.Normal * Triangle.Area;
+		Region->Area += Triangle.Area;
+		Region->Vertices.Append(Triangle.Vertices, 3);
+	}
+
+	Regions.Sort([](const FRegion& A, const FRegion& B) { return A.Area > B.Area; });
+
+	Proxies.Reset();
+	for (const FRegion& Region : Regions)
+	{
+		if (Proxies.Num() >= MaxProxies || Region.Area < TotalArea * MinAreaFraction)
+			break;
+
+		// Box X is the region's normal, Z as close to up as the plane allows so the extents line up with walls
+		const FVector Normal = Region.WeightedNormal.GetSafeNormal();
+		const FVector Reference = FMath::Abs(Normal.Z) < 0.99 ? FVector::UpVector : FVector::ForwardVector;
+		const FQuat Rotation = FRotationMatrix::MakeFromXZ(Normal, FVector::VectorPlaneProject(Reference, Normal)).ToQuat();
+
+		FBox LocalBounds(ForceInit);
+		for (const FVector& Vertex : Region.Vertices)
+			LocalBounds += Rotation.UnrotateVector(Vertex);
+
+		// Outer face on the surface, the rest of the box behind it inside the mesh
+		const FVector LocalCenter(LocalBounds.Max.X - ProxyThickness * 0.5f, LocalBounds.GetCenter().Y, LocalBounds.GetCenter().Z);
+
+		FZCClimbProxyBox& Box = Proxies.AddDefaulted_GetRef();
+		Box.Rotation = Rotation;
+		Box.Center = Rotation.RotateVector(LocalCenter);
+		Box.Extent = FVector(ProxyThickness * 0.5f, FMath::Max(1.0, LocalBounds.GetExtent().Y), FMath::Max(1.0, LocalBounds.GetExtent().Z));
+	}
+
+	SourceTriangles = CountSourceCollisionTriangles(Mesh);
+	SourceRenderTriangles = LOD.GetNumTriangles();
+	SourceBounds = Mesh->GetBoundingBox();
+
+	return true;
+}
+
+bool UZCClimbProxyUserData::IsStale() const
+{
+	const UStaticMesh* Mesh = GetTypedOuter<UStaticMesh>();
+	const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+	if (!RenderData || RenderData->LODResources.IsEmpty())
+		return false;
+
+	return RenderData->LODResources[0].GetNumTriangles() != SourceRenderTriangles || !Mesh->GetBoundingBox().Equals(SourceBounds, 0.1);
+}
+
+void UZCClimbProxyUserData::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Saving or cooking the mesh picks up any changes to its geometry
+	if (IsStale())
+		Generate();
+}
+
+void UZCClimbProxyUserData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Generate();
+}
+#endif
+
+// Returns whether Component got proxies, adding each one to OutProxies if given
+static bool AddClimbProxies(UStaticMeshComponent* Component, TArray<UBoxComponent*>* OutProxies)
+{
+	const ECollisionChannel ClimbChannel = UZCClimbingSettings::GetClimbTraceChannel();
+
+	// A box per instance would cost more than the instanced collision it replaces
+	if (Component->IsA<UInstancedStaticMeshComponent>() || !Component->IsCollisionEnabled() || Component->GetCollisionResponseToChannel(ClimbChannel) != ECR_Block)
+		return false;
+
+	UStaticMesh* Mesh = Component->GetStaticMesh();
+	const UZCClimbProxyUserData* ClimbProxy = Mesh ? Mesh->GetAssetUserData<UZCClimbProxyUserData>() : nullptr;
+	if (!ClimbProxy || ClimbProxy->GetProxies().IsEmpty())
+		return false;
+
+	AActor* Owner = Component->GetOwner();
+	for (const FZCClimbProxyBox& Box : ClimbProxy->GetProxies())
+	{
+		UBoxComponent* ProxyComponent = NewObject<UBoxComponent>(Owner, NAME_None, RF_Transient);
+		ProxyComponent->SetMobility(Component->Mobility);
+		ProxyComponent->SetupAttachment(Component);
+		ProxyComponent->SetRelativeTransform(FTransform(Box.Rotation, Box.Center));
+		ProxyComponent->InitBoxExtent(Box.Extent);
+		ProxyComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		ProxyComponent->SetCollisionObjectType(Component->GetCollisionObjectType());
+		ProxyComponent->SetCollisionResponseToAllChannels(ECR_Ignore);
+		ProxyComponent->SetCollisionResponseToChannel(ClimbChannel, ECR_Block);
+		ProxyComponent->SetGenerateOverlapEvents(false);
+		ProxyComponent->SetCanEverAffectNavigation(false);
+		ProxyComponent->RegisterComponent();
+
+		if (OutProxies)
+			OutProxies->Add(ProxyComponent);
+	}
+
+	Component->SetCollisionResponseToChannel(ClimbChannel, ECR_Ignore);
+	return true;
+}
+
+void UZCClimbProxySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (ULevel* Level : InWorld.GetLevels())
+		AddProxies(Level);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UZCClimbProxySubsystem::OnLevelAdded);
+}
+
+void UZCClimbProxySubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+	Super::Deinitialize();
+}
+
+bool UZCClimbProxySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UZCClimbProxySubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+		AddProxies(Level);
+}
+
+void UZCClimbProxySubsystem::AddProxies(ULevel* Level)
+{
+	if (!Level || !CVarClimbProxiesEnable.GetValueOnGameThread())
+		return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!Actor)
+			continue;
+
+		TInlineComponentArray<UStaticMeshComponent*> Components(Actor);
+		for (UStaticMeshComponent* Component : Components)
+			if (AddClimbProxies(Component, nullptr))
+				++NumProxiedComponents;
+	}
+}
+
+FZCClimbProxyBakeScope::FZCClimbProxyBakeScope(UWorld* World)
+{
+	const bool bHasRuntimeProxies = World && World->GetSubsystem<UZCClimbProxySubsystem>() && World->HasBegunPlay();
+	if (!World || bHasRuntimeProxies || !CVarClimbProxiesEnable.GetValueOnGameThread())
+		return;
+
+	for (ULevel* Level : World->GetLevels())
+	{
+		if (!Level)
+			continue;
+
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor)
+				continue;
+
+			TInlineComponentArray<UStaticMeshComponent*> Components(Actor);
+			for (UStaticMeshComponent* Component : Components)
+				if (AddClimbProxies(Component, &ProxyComponents))
+					ProxiedComponents.Add(Component);
+		}
+	}
+}
+
+FZCClimbProxyBakeScope::~FZCClimbProxyBakeScope()
+{
+	for (UBoxComponent* ProxyComponent : ProxyComponents)
+		if (IsValid(ProxyComponent))
+			ProxyComponent->DestroyComponent();
+
+	// Proxies are only added to components that blocked the channel
+	const ECollisionChannel ClimbChannel = UZCClimbingSettings::GetClimbTraceChannel();
+	for (UStaticMeshComponent* Component : ProxiedComponents)
+		if (IsValid(Component))
+			Component->SetCollisionResponseToChannel(ClimbChannel, ECR_Block);
+}
+
+static FAutoConsoleCommand ClimbProxyReportCommand(
+	TEXT("ZC.ClimbProxies.Report"),
+	TEXT("Lists every loaded mesh with a climb proxy, with the triangle count of its collision and of its proxy"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		int32 TotalSource = 0;
+		int32 TotalProxy = 0;
+		int32 NumMeshes = 0;
+
+		for (TObjectIterator<UStaticMesh> It; It; ++It)
+		{
+			const UZCClimbProxyUserData* ClimbProxy = It->GetAssetUserData<UZCClimbProxyUserData>();
+			if (!ClimbProxy)
+				continue;
+
+			UE_LOG(LogZCClimbing, Display, TEXT("    %s: %d source triangles, %d boxes, %d proxy triangles"),
+				*It->GetPathName(), ClimbProxy->GetSourceTriangles(), ClimbProxy->GetProxies().Num(), ClimbProxy->GetProxyTriangles());
+
+			TotalSource += ClimbProxy->GetSourceTriangles();
+			TotalProxy += ClimbProxy->GetProxyTriangles();
+			++NumMeshes;
+		}
+
+		UE_LOG(LogZCClimbing, Display, TEXT("ZC.ClimbProxies.Report: %d meshes, %d source triangles, %d proxy triangles"), NumMeshes, TotalSource, TotalProxy);
+	}));
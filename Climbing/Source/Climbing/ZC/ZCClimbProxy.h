@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ZCClimbProxy.generated.h"
+
+class UBoxComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+// Oriented box in the mesh's space, with its outer face on one of the mesh's planar surfaces
+USTRUCT()
+struct FZCClimbProxyBox
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	FVector Center = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	FQuat Rotation = FQuat::Identity;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	FVector Extent = FVector::ZeroVector;
+};
+
+/**
+ * Marks a static mesh as climbable and holds the simplified collision climbing queries run against instead of the mesh's own.
+ * Add it to the mesh's Asset User Data. The proxy is rebuilt from the mesh's triangles whenever the mesh is saved with different
+ * geometry, or by the ZCClimbProxy commandlet. It's a handful of thin boxes, one per large planar region, so sweeps against it are
+ * cheap and every hit on a region returns the same normal.
+ */
+UCLASS(meta = (DisplayName = "Climb Proxy"))
+class CLIMBING_API UZCClimbProxyUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	const TArray<FZCClimbProxyBox>& GetProxies() const { return Proxies; }
+	int32 GetSourceTriangles() const { return SourceTriangles; }
+	int32 GetProxyTriangles() const { return Proxies.Num() * 12; }
+
+	static int32 CountSourceCollisionTriangles(const UStaticMesh* Mesh);
+
+#if WITH_EDITOR
+	// Rebuilds the proxy from the owning mesh. Returns false if the mesh has no CPU side geometry to build it from.
+	bool Generate();
+	bool IsStale() const;
+
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	// Most boxes the proxy may use. The largest planar regions get one each, smaller ones are left out.
+	UPROPERTY(EditAnywhere, Category = "Climbing", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxProxies = 8;
+
+	// Triangles within this many degrees of a region's normal are part of it
+	UPROPERTY(EditAnywhere, Category = "Climbing", meta = (ClampMin = "0.0", ClampMax = "45.0"))
+	float PlanarAngleTolerance = 15.f;
+
+	// And within this distance of its plane
+	UPROPERTY(EditAnywhere, Category = "Climbing", meta = (ClampMin = "0.0", ClampMax = "100.0"))
+	float PlanarDistanceTolerance = 5.f;
+
+	// Regions smaller than this fraction of the mesh's surface area don't get a box
+	UPROPERTY(EditAnywhere, Category = "Climbing", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float MinAreaFraction = 0.02f;
+
+	// How deep each box reaches into the mesh behind its surface
+	UPROPERTY(EditAnywhere, Category = "Climbing", meta = (ClampMin = "1.0", ClampMax = "100.0"))
+	float ProxyThickness = 10.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	TArray<FZCClimbProxyBox> Proxies;
+
+	// Triangles in the collision the proxy replaces, for the report
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	int32 SourceTriangles = 0;
+
+	// What the proxy was built from, so it can tell when the mesh changed
+	UPROPERTY()
+	int32 SourceRenderTriangles = 0;
+	UPROPERTY()
+	FBox SourceBounds = FBox(ForceInit);
+};
+
+/**
+ * Gives every static mesh component whose mesh has a climb proxy a set of query only boxes that block the climbable channel,
+ * and takes the mesh itself off that channel. Climbing queries then only see the proxies. Instanced meshes keep their own collision.
+ */
+UCLASS()
+class CLIMBING_API UZCClimbProxySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	int32 GetNumProxiedComponents() const { return NumProxiedComponents; }
+
+private:
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void AddProxies(ULevel* Level);
+
+	FDelegateHandle LevelAddedHandle;
+	int32 NumProxiedComponents = 0;
+};
+
+/**
+ * Puts the climb proxies in place for as long as it's in scope, so offline bakes trace the same geometry as climbing queries at runtime.
+ * Does nothing in worlds UZCClimbProxySubsystem has already done it for, or with ZC.ClimbProxies.Enable off, since runtime queries see the meshes then.
+ */
+class CLIMBING_API FZCClimbProxyBakeScope
+{
+public:
+	explicit FZCClimbProxyBakeScope(UWorld* World);
+	~FZCClimbProxyBakeScope();
+
+private:
+	TArray<UStaticMeshComponent*> ProxiedComponents;
+	TArray<UBoxComponent*> ProxyComponents;
+};
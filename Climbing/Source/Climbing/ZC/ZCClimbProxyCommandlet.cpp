@@ -0,0 +1,94 @@
+#include "Climbing/ZC/ZCClimbProxyCommandlet.h"
+#include "Climbing/ZC/ZCClimbProxy.h"
+#include "Climbing/Climbing.h"
+
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UZCClimbProxyCommandlet::UZCClimbProxyCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UZCClimbProxyCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString PathsParam = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathsParam, false);
+	const bool bReportOnly = FParse::Param(*Params, TEXT("ReportOnly"));
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("ClimbProxyReport.csv");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	TArray<FString> Paths;
+	PathsParam.ParseIntoArray(Paths, TEXT("+"));
+
+	TArray<FString> ReportRows;
+	ReportRows.Add(TEXT("Mesh,SourceTriangles,ProxyBoxes,ProxyTriangles,Reduction"));
+
+	int32 NumFailed = 0;
+	int32 TotalSource = 0;
+	int32 TotalProxy = 0;
+
+	for (const FString& Path : Paths)
+	{
+		TArray<UObject*> Assets;
+		EngineUtils::FindOrLoadAssetsByPath(Path, Assets, EngineUtils::ATL_Regular);
+
+		for (UObject* Asset : Assets)
+		{
+			UStaticMesh* Mesh = Cast<UStaticMesh>(Asset);
+			UZCClimbProxyUserData* ClimbProxy = Mesh ? Mesh->GetAssetUserData<UZCClimbProxyUserData>() : nullptr;
+			if (!ClimbProxy)
+				continue;
+
+			if (!bReportOnly)
+			{
+				if (!ClimbProxy->Generate())
+				{
+					UE_LOG(LogZCClimbing, Error, TEXT("Couldn't build a climb proxy for %s, it has no geometry loaded"), *Mesh->GetPathName());
+					++NumFailed;
+					continue;
+				}
+
+				UPackage* Package = Mesh->GetPackage();
+				Package->MarkPackageDirty();
+
+				const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+				FSavePackageArgs SaveArgs;
+				SaveArgs.TopLevelFlags = RF_Standalone;
+				if (!UPackage::SavePackage(Package, Mesh, *Filename, SaveArgs))
+				{
+					UE_LOG(LogZCClimbing, Error, TEXT("Couldn't save %s"), *Filename);
+					++NumFailed;
+				}
+			}
+
+			const int32 SourceTriangles = ClimbProxy->GetSourceTriangles();
+			const int32 ProxyTriangles = ClimbProxy->GetProxyTriangles();
+			TotalSource += SourceTriangles;
+			TotalProxy += ProxyTriangles;
+
+			ReportRows.Add(FString::Printf(TEXT("%s,%d,%d,%d,%.2f"), *Mesh->GetPathName(), SourceTriangles, ClimbProxy->GetProxies().Num(), ProxyTriangles,
+				ProxyTriangles > 0 ? static_cast<float>(SourceTriangles) / ProxyTriangles : 0.f));
+		}
+	}
+
+	FFileHelper::SaveStringArrayToFile(ReportRows, *ReportPath);
+
+	UE_LOG(LogZCClimbing, Display, TEXT("Climb proxies: %d meshes, %d source triangles, %d proxy triangles, report written to %s"),
+		ReportRows.Num() - 1, TotalSource, TotalProxy, *ReportPath);
+
+	return NumFailed > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
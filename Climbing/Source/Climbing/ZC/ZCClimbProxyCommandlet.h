@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ZCClimbProxyCommandlet.generated.h"
+
+/**
+ * Rebuilds the climb proxy of every static mesh under the given content paths that has one, saves them, and writes a report
+ * comparing each proxy's triangle count with the collision it replaces. Climb grids and ledge graphs trace the proxies, rebake them
+ * afterwards (ZCLedgeBake for ledge graphs).
+ * Usage: UnrealEditor-Cmd <Project> -run=ZCClimbProxy [-Paths=/Game/A+/Game/B] [-ReportOnly] [-Report=<File>.csv]
+ */
+UCLASS()
+class CLIMBING_API UZCClimbProxyCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UZCClimbProxyCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,345 @@
+#include "Climbing/ZC/ZCClimbReplay.h"
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/Climbing.h"
+
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "GameFramework/PlayerController.h"
+
+bool FZCClimbInputRecording::SaveToFile(const FString& FilePath) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Frames.Num() + 2);
+	Lines.Add(FString::Printf(TEXT("# Map=%s"), *MapName));
+	Lines.Add(TEXT("DeltaTime,MoveX,MoveY,HasMove,Actions,ControlPitch,ControlYaw,ControlRoll"));
+
+	for (const FZCClimbInputFrame& Frame : Frames)
+		Lines.Add(FString::Printf(TEXT("%.9g,%.9g,%.9g,%d,%d,%.9g,%.9g,%.9g"), Frame.DeltaTime, Frame.Move.X, Frame.Move.Y, Frame.bHasMove ? 1 : 0, static_cast<int32>(Frame.Actions),
+			Frame.ControlRotation.Pitch, Frame.ControlRotation.Yaw, Frame.ControlRotation.Roll));
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
+
+bool FZCClimbInputRecording::LoadFromFile(const FString& FilePath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+		return false;
+
+	Frames.Reset();
+	for (const FString& Line : Lines)
+	{
+		if (Line.StartsWith(TEXT("# Map=")))
+		{
+			MapName = Line.RightChop(6);
+			continue;
+		}
+
+		// Older recordings stop after the actions
+		TArray<FString> Columns;
+		const int32 NumColumns = Line.ParseIntoArray(Columns, TEXT(","));
+		if ((NumColumns != 5 && NumColumns != 8) || !Columns[0].IsNumeric())
+			continue;
+
+		FZCClimbInputFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.DeltaTime = FCString::Atof(*Columns[0]);
+		Frame.Move = FVector2D(FCString::Atof(*Columns[1]), FCString::Atof(*Columns[2]));
+		Frame.bHasMove = FCString::Atoi(*Columns[3]) != 0;
+		Frame.Actions = static_cast<EZCClimbInputAction>(FCString::Atoi(*Columns[4]));
+		if (NumColumns == 8)
+		{
+			Frame.ControlRotation = FRotator(FCString::Atof(*Columns[5]), FCString::Atof(*Columns[6]), FCString::Atof(*Columns[7]));
+			Frame.bHasControlRotation = true;
+		}
+	}
+
+	return Frames.Num() > 0;
+}
+
+FString FZCClimbInputRecording::GetReplayDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ClimbReplays");
+}
+
+UZCClimbReplayComponent::UZCClimbReplayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UZCClimbReplayComponent::StartRecording()
+{
+	if (Mode != EZCClimbReplayMode::Idle)
+		return;
+
+	TickInputAfterController();
+
+	Recording = FZCClimbInputRecording();
+	Recording.MapName = GetWorld()->GetMapName();
+	PendingFrame = FZCClimbInputFrame();
+	Mode = EZCClimbReplayMode::Recording;
+}
+
+bool UZCClimbReplayComponent::StopRecording(const FString& Name)
+{
+	if (!IsRecording())
+		return false;
+
+	Mode = EZCClimbReplayMode::Idle;
+
+	const FString FilePath = FZCClimbInputRecording::GetReplayDirectory() / (Name + TEXT(".csv"));
+	const bool bSaved = Recording.SaveToFile(FilePath);
+	UE_LOG(LogZCClimbing, Display, TEXT("Climb recording of %d frames %s %s"), Recording.Frames.Num(), bSaved ? TEXT("saved to") : TEXT("failed to save to"), *FilePath);
+
+	return bSaved;
+}
+
+bool UZCClimbReplayComponent::StartReplay(const FString& Name, bool bExitWhenDone)
+{
+	if (Mode != EZCClimbReplayMode::Idle)
+		return false;
+
+	const FString FilePath = FZCClimbInputRecording::GetReplayDirectory() / (Name + TEXT(".csv"));
+	if (!Recording.LoadFromFile(FilePath))
+	{
+		UE_LOG(LogZCClimbing, Error, TEXT("Couldn't load climb recording %s"), *FilePath);
+		return false;
+	}
+
+	if (Recording.MapName != GetWorld()->GetMapName())
+		UE_LOG(LogZCClimbing, Warning, TEXT("Climb recording %s was made on %s but is replaying on %s"), *Name, *Recording.MapName, *GetWorld()->GetMapName());
+	if (!Recording.Frames[0].bHasControlRotation)
+		UE_LOG(LogZCClimbing, Warning, TEXT("Climb recording %s has no control rotation, walking input will follow the live camera and won't replay the same way"), *Name);
+
+	TickInputAfterController();
+
+	// Run the engine at the recorded frame times so every frame simulates exactly what was recorded
+	bWasUsingFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Recording.Frames[0].DeltaTime);
+
+	if (UZCCharacterMovementComponent* Movement = GetClimbingCharacter()->GetZCMovementComponent())
+		Movement->ResetClimbingProfile();
+
+	ReplayName = Name;
+	ReplayFrame = 0;
+	ReplayRows.Reset();
+	ReplayTotals.Reset();
+	bExitWhenReplayDone = bExitWhenDone;
+	Mode = EZCClimbReplayMode::Replaying;
+
+	return true;
+}
+
+bool UZCClimbReplayComponent::HandleMoveInput(const FVector2D& Move)
+{
+	if (ShouldBlockLiveInput())
+		return false;
+
+	if (IsRecording())
+	{
+		PendingFrame.Move = Move;
+		PendingFrame.bHasMove = true;
+		RecordControlRotation();
+	}
+
+	return true;
+}
+
+bool UZCClimbReplayComponent::HandleActionInput(EZCClimbInputAction Action)
+{
+	if (ShouldBlockLiveInput())
+		return false;
+
+	if (IsRecording())
+		PendingFrame.Actions |= Action;
+
+	return true;
+}
+
+void UZCClimbReplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (IsRecording())
+	{
+		// Input for this frame has already been processed by the controller, close the frame off
+		if (!PendingFrame.bHasControlRotation)
+			RecordControlRotation();
+		PendingFrame.DeltaTime = DeltaTime;
+		Recording.Frames.Add(PendingFrame);
+		PendingFrame = FZCClimbInputFrame();
+	}
+	else if (IsReplaying())
+	{
+		// Movement for the previous replay frame has run, grab its numbers before feeding in the next frame
+		if (ReplayFrame > 0)
+			CaptureReplayFrame(ReplayFrame - 1);
+
+		if (ReplayFrame >= Recording.Frames.Num())
+		{
+			FinishReplay();
+			return;
+		}
+
+		ApplyReplayFrame(Recording.Frames[ReplayFrame]);
+		++ReplayFrame;
+
+		if (Recording.Frames.IsValidIndex(ReplayFrame))
+			FApp::SetFixedDeltaTime(Recording.Frames[ReplayFrame].DeltaTime);
+	}
+}
+
+void UZCClimbReplayComponent::TickInputAfterController()
+{
+	// Input has to be in before this ticks, and this has to tick before the movement component consumes it
+	const AZCClimbingCharacter* Character = GetClimbingCharacter();
+	if (AController* Controller = Character->GetController())
+		PrimaryComponentTick.AddPrerequisite(Controller, Controller->PrimaryActorTick);
+
+	if (UZCCharacterMovementComponent* Movement = Character->GetZCMovementComponent())
+		Movement->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+}
+
+void UZCClimbReplayComponent::RecordControlRotation()
+{
+	// Taken when the move input comes in, before the controller applies this frame's look input, since that's the rotation Move uses
+	if (const AController* Controller = GetClimbingCharacter()->GetController())
+	{
+		PendingFrame.ControlRotation = Controller->GetControlRotation();
+		PendingFrame.bHasControlRotation = true;
+	}
+}
+
+void UZCClimbReplayComponent::ApplyReplayFrame(const FZCClimbInputFrame& Frame)
+{
+	AZCClimbingCharacter* Character = GetClimbingCharacter();
+	TGuardValue<bool> ApplyingReplayInput(bApplyingReplayInput, true);
+
+	// Overrides whatever look input the controller picked up this frame
+	if (AController* Controller = Character->GetController())
+		if (Frame.bHasControlRotation)
+			Controller->SetControlRotation(Frame.ControlRotation);
+
+	// Same order the input component fires them in
+	if (Frame.bHasMove)
+		Character->Move(FInputActionValue(Frame.Move));
+	if (EnumHasAnyFlags(Frame.Actions, EZCClimbInputAction::Climb))
+		Character->Climb(FInputActionValue(true));
+	if (EnumHasAnyFlags(Frame.Actions, EZCClimbInputAction::CancelClimb))
+		Character->CancelClimb(FInputActionValue(true));
+	if (EnumHasAnyFlags(Frame.Actions, EZCClimbInputAction::ClimbDash))
+		Character->ClimbDash(FInputActionValue(true));
+}
+
+void UZCClimbReplayComponent::CaptureReplayFrame(int32 FrameIndex)
+{
+	const AZCClimbingCharacter* Character = GetClimbingCharacter();
+	UZCCharacterMovementComponent* Movement = Character->GetZCMovementComponent();
+	if (!Movement)
+		return;
+
+	const FZCClimbingProfile& Profile = Movement->GetClimbingProfile();
+	ReplayTotals.Accumulate(Profile);
+
+	const FVector Location = Character->GetActorLocation();
+	const FRotator Rotation = Character->GetActorRotation();
+
+	FString Row = FString::Printf(TEXT("%d,%.9g"), FrameIndex, Recording.Frames[FrameIndex].DeltaTime);
+	for (int32 Stage = 0; Stage < static_cast<int32>(EZCClimbStage::Num); ++Stage)
+		Row += FString::Printf(TEXT(",%.4f"), Profile.GetStageMilliseconds(static_cast<EZCClimbStage>(Stage)));
+	Row += FString::Printf(TEXT(",%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d"),
+		Profile.Sweeps, Profile.LineTraces, Profile.Overlaps, Profile.HitsReturned, Profile.QueryCacheHits, Profile.QueryCacheMisses, Profile.BudgetOverruns,
+		Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll,
+		Movement->IsClimbing() ? 1 : 0);
+	ReplayRows.Add(MoveTemp(Row));
+
+	Movement->ResetClimbingProfile();
+}
+
+void UZCClimbReplayComponent::FinishReplay()
+{
+	Mode = EZCClimbReplayMode::Idle;
+	FApp::SetUseFixedTimeStep(bWasUsingFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+	const FString ResultPath = FZCClimbInputRecording::GetReplayDirectory() / (ReplayName + TEXT("_Result"));
+
+	FString Header = TEXT("Frame,DeltaTime");
+	for (int32 Stage = 0; Stage < static_cast<int32>(EZCClimbStage::Num); ++Stage)
+		Header += FString::Printf(TEXT(",%sMs"), GetClimbStageName(static_cast<EZCClimbStage>(Stage)));
+	Header += TEXT(",Sweeps,LineTraces,Overlaps,Hits,QueryCacheHits,QueryCacheMisses,BudgetOverruns,X,Y,Z,Pitch,Yaw,Roll,Climbing");
+	ReplayRows.Insert(Header, 0);
+	FFileHelper::SaveStringArrayToFile(ReplayRows, *(ResultPath + TEXT(".csv")));
+
+	const AZCClimbingCharacter* Character = GetClimbingCharacter();
+	const FVector Location = Character->GetActorLocation();
+	const FRotator Rotation = Character->GetActorRotation();
+
+	FString StageTotals;
+	for (int32 Stage = 0; Stage < static_cast<int32>(EZCClimbStage::Num); ++Stage)
+		StageTotals += FString::Printf(TEXT("%s\t\t\"%s\": %.4f"), Stage > 0 ? TEXT(",\n") : TEXT(""), GetClimbStageName(static_cast<EZCClimbStage>(Stage)), ReplayTotals.GetStageMilliseconds(static_cast<EZCClimbStage>(Stage)));
+
+	const FString Summary = FString::Printf(TEXT("{\n\t\"recording\": \"%s\",\n\t\"map\": \"%s\",\n\t\"frames\": %d,\n\t\"stageMs\": {\n%s\n\t},\n\t\"sweeps\": %d,\n\t\"lineTraces\": %d,\n\t\"overlaps\": %d,\n\t\"hits\": %d,\n\t\"queryCacheHits\": %d,\n\t\"queryCacheMisses\": %d,\n\t\"queryCacheHitRate\": %.3f,\n\t\"climbTicks\": %d,\n\t\"peakTickQueries\": %d,\n\t\"peakTickMicroseconds\": %.1f,\n\t\"budgetOverruns\": %d,\n\t\"finalLocation\": [%.3f, %.3f, %.3f],\n\t\"finalRotation\": [%.3f, %.3f, %.3f]\n}\n"),
+		*ReplayName, *GetWorld()->GetMapName(), Recording.Frames.Num(), *StageTotals,
+		ReplayTotals.Sweeps, ReplayTotals.LineTraces, ReplayTotals.Overlaps, ReplayTotals.HitsReturned,
+		ReplayTotals.QueryCacheHits, ReplayTotals.QueryCacheMisses, ReplayTotals.GetQueryCacheHitRate(),
+		ReplayTotals.ClimbTicks, ReplayTotals.PeakTickQueries, ReplayTotals.GetPeakTickMicroseconds(), ReplayTotals.BudgetOverruns,
+		Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+	FFileHelper::SaveStringToFile(Summary, *(ResultPath + TEXT(".json")));
+
+	UE_LOG(LogZCClimbing, Display, TEXT("Climb replay %s finished, results written to %s.csv/.json"), *ReplayName, *ResultPath);
+
+	if (ReplayTotals.BudgetOverruns > 0)
+		UE_LOG(LogZCClimbing, Error, TEXT("Climb replay %s went over the climbing tick budget %d times"), *ReplayName, ReplayTotals.BudgetOverruns);
+
+	// A non-zero exit code lets automated runs fail on a budget regression
+	if (bExitWhenReplayDone)
+		FPlatformMisc::RequestExitWithStatus(false, ReplayTotals.BudgetOverruns > 0 ? 1 : 0);
+}
+
+AZCClimbingCharacter* UZCClimbReplayComponent::GetClimbingCharacter() const
+{
+	return CastChecked<AZCClimbingCharacter>(GetOwner());
+}
+
+static UZCClimbReplayComponent* GetLocalClimbReplay(UWorld* World)
+{
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	AZCClimbingCharacter* Character = PlayerController ? Cast<AZCClimbingCharacter>(PlayerController->GetPawn()) : nullptr;
+
+	return Character ? Character->GetOrCreateClimbReplay() : nullptr;
+}
+
+static FAutoConsoleCommandWithWorld ClimbRecordCommand(
+	TEXT("ZC.Replay.Record"),
+	TEXT("Starts recording the local climbing character's input"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UZCClimbReplayComponent* Replay = GetLocalClimbReplay(World))
+			Replay->StartRecording();
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs ClimbStopRecordingCommand(
+	TEXT("ZC.Replay.Stop"),
+	TEXT("Stops recording and saves it to Saved/ClimbReplays/<Name>.csv\n")
+	TEXT("Usage: ZC.Replay.Stop <Name>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UZCClimbReplayComponent* Replay = GetLocalClimbReplay(World))
+			Replay->StopRecording(Args.Num() > 0 ? Args[0] : TEXT("ClimbRecording"));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs ClimbPlayCommand(
+	TEXT("ZC.Replay.Play"),
+	TEXT("Replays Saved/ClimbReplays/<Name>.csv on the local climbing character at the recorded frame times and writes <Name>_Result.csv/.json\n")
+	TEXT("Usage: ZC.Replay.Play <Name> [exit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UZCClimbReplayComponent* Replay = GetLocalClimbReplay(World);
+		if (Replay && Args.Num() > 0)
+			Replay->StartReplay(Args[0], Args.Contains(TEXT("exit")));
+	}));
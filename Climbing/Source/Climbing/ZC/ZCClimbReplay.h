@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "ZCClimbReplay.generated.h"
+
+enum class EZCClimbInputAction : uint8
+{
+	None			= 0,
+	Climb			= 1 << 0,
+	CancelClimb		= 1 << 1,
+	ClimbDash		= 1 << 2,
+};
+ENUM_CLASS_FLAGS(EZCClimbInputAction);
+
+// Everything AZCClimbingCharacter received from input during one frame
+struct FZCClimbInputFrame
+{
+	float DeltaTime = 0.f;
+	FVector2D Move = FVector2D::ZeroVector;
+	bool bHasMove = false;
+	EZCClimbInputAction Actions = EZCClimbInputAction::None;
+	// What Move turns the input into a direction with. Recordings made before it was captured don't have it.
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	bool bHasControlRotation = false;
+};
+
+struct FZCClimbInputRecording
+{
+	FString MapName;
+	TArray<FZCClimbInputFrame> Frames;
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	// Recordings and replay results live under Saved/ClimbReplays
+	static FString GetReplayDirectory();
+};
+
+UENUM()
+enum class EZCClimbReplayMode : uint8
+{
+	Idle,
+	Recording,
+	Replaying,
+};
+
+/**
+ * Records the climbing character's input stream with its frame times, and plays it back at a fixed timestep.
+ * A replay writes per frame climbing stage timings, scene query counts and transforms to CSV, plus a JSON summary with the final transform,
+ * so climbing cost and behaviour can be diffed between builds.
+ */
+UCLASS()
+class CLIMBING_API UZCClimbReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UZCClimbReplayComponent();
+
+	void StartRecording();
+	bool StopRecording(const FString& Name);
+	bool StartReplay(const FString& Name, bool bExitWhenDone);
+
+	bool IsRecording() const { return Mode == EZCClimbReplayMode::Recording; }
+	bool IsReplaying() const { return Mode == EZCClimbReplayMode::Replaying; }
+
+	// Records the input when recording. Returns false if it should be ignored because a replay is driving the character.
+	bool HandleMoveInput(const FVector2D& Move);
+	bool HandleActionInput(EZCClimbInputAction Action);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	bool ShouldBlockLiveInput() const { return IsReplaying() && !bApplyingReplayInput; }
+	void TickInputAfterController();
+	void RecordControlRotation();
+	void ApplyReplayFrame(const FZCClimbInputFrame& Frame);
+	void CaptureReplayFrame(int32 FrameIndex);
+	void FinishReplay();
+
+	class AZCClimbingCharacter* GetClimbingCharacter() const;
+
+	EZCClimbReplayMode Mode = EZCClimbReplayMode::Idle;
+	FZCClimbInputRecording Recording;
+	FZCClimbInputFrame PendingFrame;
+
+	FString ReplayName;
+	int32 ReplayFrame = 0;
+	bool bApplyingReplayInput = false;
+	bool bExitWhenReplayDone = false;
+	bool bWasUsingFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+
+	TArray<FString> ReplayRows;
+	FZCClimbingProfile ReplayTotals;
+};
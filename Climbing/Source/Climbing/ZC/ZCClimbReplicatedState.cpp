@@ -0,0 +1,169 @@
+#include "Climbing/ZC/ZCClimbReplicatedState.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/Climbing.h"
+
+#include "GameFramework/Character.h"
+#include "EngineUtils.h"
+
+static constexpr int32 NormalComponentBits = 12;
+static constexpr int32 DashDirectionComponentBits = 8;
+// Half centimetres, up to 127.5
+static constexpr float DistanceStep = 0.5f;
+
+static int64 GReceivedClimbStateBits = 0;
+static int32 GReceivedClimbStateUpdates = 0;
+
+// Octahedral encoding: the unit vector is projected onto an octahedron and unfolded into a square, both coordinates quantized to Bits
+static uint32 PackUnitVector(const FVector& Vector, int32 Bits)
+{
+	const FVector Unit = Vector.GetSafeNormal();
+	const double L1 = FMath::Abs(Unit.X) + FMath::Abs(Unit.Y) + FMath::Abs(Unit.Z);
+	if (L1 <= 0.0)
+		return 0;
+
+	double X = Unit.X / L1;
+	double Y = Unit.Y / L1;
+	if (Unit.Z < 0.0)
+	{
+		const double FoldedX = (1.0 - FMath::Abs(Y)) * (X >= 0.0 ? 1.0 : -1.0);
+		const double FoldedY = (1.0 - FMath::Abs(X)) * (Y >= 0.0 ? 1.0 : -1.0);
+		X = FoldedX;
+		Y = FoldedY;
+	}
+
+	const uint32 MaxValue = (1u << Bits) - 1;
+	const uint32 QuantizedX = static_cast<uint32>(FMath::RoundToInt((X * 0.5 + 0.5) * MaxValue));
+	const uint32 QuantizedY = static_cast<uint32>(FMath::RoundToInt((Y * 0.5 + 0.5) * MaxValue));
+	return (QuantizedX << Bits) | QuantizedY;
+}
+
+static FVector UnpackUnitVector(uint32 Packed, int32 Bits)
+{
+	const uint32 MaxValue = (1u << Bits) - 1;
+	const double X = ((Packed >> Bits) & MaxValue) / static_cast<double>(MaxValue) * 2.0 - 1.0;
+	const double Y = (Packed & MaxValue) / static_cast<double>(MaxValue) * 2.0 - 1.0;
+
+	FVector Unit(X, Y, 1.0 - FMath::Abs(X) - FMath::Abs(Y));
+	if (Unit.Z < 0.0)
+	{
+		Unit.X = (1.0 - FMath::Abs(Y)) * (X >= 0.0 ? 1.0 : -1.0);
+		Unit.Y = (1.0 - FMath::Abs(X)) * (Y >= 0.0 ? 1.0 : -1.0);
+	}
+
+	return Unit.GetSafeNormal();
+}
+
+void FZCReplicatedClimbState::Pack(const FVector& SurfaceNormal, float ContactDistance, bool bInIsClimbDashing, const FVector& DashDirection, bool bInIsLedgeClimbing)
+{
+	PackedNormal = PackUnitVector(SurfaceNormal, NormalComponentBits);
+	PackedDistance = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(ContactDistance / DistanceStep), 0, 255));
+	bIsClimbDashing = bInIsClimbDashing;
+	// Zeroed outside a dash so a stale direction never causes an update
+	PackedDashDirection = bIsClimbDashing ? static_cast<uint16>(PackUnitVector(DashDirection, DashDirectionComponentBits)) : 0;
+	bIsLedgeClimbing = bInIsLedgeClimbing;
+}
+
+bool FZCReplicatedClimbState::IsCleared() const
+{
+	return PackedNormal == 0 && PackedDistance == 0 && !bIsClimbDashing && !bIsLedgeClimbing;
+}
+
+FVector FZCReplicatedClimbState::GetSurfaceNormal() const
+{
+	return UnpackUnitVector(PackedNormal, NormalComponentBits);
+}
+
+float FZCReplicatedClimbState::GetContactDistance() const
+{
+	return PackedDistance * DistanceStep;
+}
+
+FVector FZCReplicatedClimbState::GetDashDirection() const
+{
+	return bIsClimbDashing ? UnpackUnitVector(PackedDashDirection, DashDirectionComponentBits) : FVector::ZeroVector;
+}
+
+bool FZCReplicatedClimbState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar.SerializeBits(&bIsClimbDashing, 1);
+	Ar.SerializeBits(&bIsLedgeClimbing, 1);
+	Ar.SerializeInt(PackedNormal, 1u << (NormalComponentBits * 2));
+	Ar << PackedDistance;
+
+	if (bIsClimbDashing)
+	{
+		uint32 DashDirection = PackedDashDirection;
+		Ar.SerializeInt(DashDirection, 1u << (DashDirectionComponentBits * 2));
+		PackedDashDirection = static_cast<uint16>(DashDirection);
+	}
+	else
+	{
+		PackedDashDirection = 0;
+	}
+
+	if (Ar.IsLoading())
+	{
+		GReceivedClimbStateBits += 2 + NormalComponentBits * 2 + 8 + (bIsClimbDashing ? DashDirectionComponentBits * 2 : 0);
+		++GReceivedClimbStateUpdates;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+int64 FZCReplicatedClimbState::GetReceivedBits()
+{
+	return GReceivedClimbStateBits;
+}
+
+int32 FZCReplicatedClimbState::GetReceivedUpdates()
+{
+	return GReceivedClimbStateUpdates;
+}
+
+void FZCReplicatedClimbState::ResetReceivedCounters()
+{
+	GReceivedClimbStateBits = 0;
+	GReceivedClimbStateUpdates = 0;
+}
+
+// Run on a client. Compare against a run with ZC.ClimbState.ProxyProbes 1 for the client CPU the replicated state saves.
+static FAutoConsoleCommandWithWorld ClimbStateReportCommand(
+	TEXT("ZC.ClimbState.Report"),
+	TEXT("Reports the replicated climbing state received and the climbing query cost of simulated proxies since the last report"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		static double LastReportTime = FPlatformTime::Seconds();
+		static uint64 LastReportFrame = GFrameCounter;
+
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - LastReportTime, UE_KINDA_SMALL_NUMBER);
+		const uint64 Frames = FMath::Max<uint64>(GFrameCounter - LastReportFrame, 1);
+
+		int32 NumProxies = 0;
+		int32 NumClimbing = 0;
+		FZCClimbingProfile ProxyProfile;
+		for (TActorIterator<ACharacter> It(World); It; ++It)
+		{
+			UZCCharacterMovementComponent* Movement = Cast<UZCCharacterMovementComponent>(It->GetCharacterMovement());
+			if (!Movement || It->GetLocalRole() != ROLE_SimulatedProxy)
+				continue;
+
+			++NumProxies;
+			NumClimbing += Movement->IsClimbing() ? 1 : 0;
+			ProxyProfile.Accumulate(Movement->GetClimbingProfile());
+			Movement->ResetClimbingProfile();
+		}
+
+		const double Bytes = FZCReplicatedClimbState::GetReceivedBits() / 8.0;
+		const double QueryMs = ProxyProfile.GetStageMilliseconds(EZCClimbStage::WallSweep) + ProxyProfile.GetStageMilliseconds(EZCClimbStage::SurfaceInfo);
+
+		UE_LOG(LogZCClimbing, Display, TEXT("ZC.ClimbState.Report: %d simulated proxies, %d climbing, over %.1f s"), NumProxies, NumClimbing, Seconds);
+		// Only the climb state's own bits. Property headers, bunches and packets come on top, Networking Insights shows what it really costs.
+		UE_LOG(LogZCClimbing, Display, TEXT("    Received: %d updates, %.0f payload bytes, %.1f payload bytes/s per climbing proxy (excludes replication overhead)"),
+			FZCReplicatedClimbState::GetReceivedUpdates(), Bytes, NumClimbing > 0 ? Bytes / Seconds / NumClimbing : 0.0);
+		UE_LOG(LogZCClimbing, Display, TEXT("    Proxy climbing queries: %d, %.3f ms/frame"), ProxyProfile.GetNumQueries(), QueryMs / Frames);
+
+		FZCReplicatedClimbState::ResetReceivedCounters();
+		LastReportTime = FPlatformTime::Seconds();
+		LastReportFrame = GFrameCounter;
+	}));
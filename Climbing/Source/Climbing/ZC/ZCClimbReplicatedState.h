@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ZCClimbReplicatedState.generated.h"
+
+/**
+ * The server's climbing surface and dash state, quantized for simulated proxies so they can follow it instead of probing the wall
+ * themselves. The normal is octahedral encoded in 24 bits, the distance to the surface in half centimetres, and the dash direction
+ * is only sent while dashing. 34 bits a change, 50 while dashing.
+ */
+USTRUCT()
+struct CLIMBING_API FZCReplicatedClimbState
+{
+	GENERATED_BODY()
+
+	void Pack(const FVector& SurfaceNormal, float ContactDistance, bool bInIsClimbDashing, const FVector& DashDirection, bool bInIsLedgeClimbing);
+	// What the server sends while not climbing, so nothing from the last climb is left set
+	void Clear() { *this = FZCReplicatedClimbState(); }
+	// A climbing state only ever matches a cleared one by chance, and then just until it next changes
+	bool IsCleared() const;
+
+	FVector GetSurfaceNormal() const;
+	float GetContactDistance() const;
+	FVector GetDashDirection() const;
+	bool IsClimbDashing() const { return bIsClimbDashing; }
+	bool IsLedgeClimbing() const { return bIsLedgeClimbing; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Climb state bits received by this process since the last ZC.ClimbState.Report, without any property, bunch or packet overhead
+	static int64 GetReceivedBits();
+	static int32 GetReceivedUpdates();
+	static void ResetReceivedCounters();
+
+private:
+	// Only the quantized values are properties, so nothing is sent until one of them changes
+	UPROPERTY()
+	uint32 PackedNormal = 0;
+	UPROPERTY()
+	uint8 PackedDistance = 0;
+	UPROPERTY()
+	uint16 PackedDashDirection = 0;
+	UPROPERTY()
+	bool bIsClimbDashing = false;
+	UPROPERTY()
+	bool bIsLedgeClimbing = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FZCReplicatedClimbState> : public TStructOpsTypeTraitsBase2<FZCReplicatedClimbState>
+{
+	enum { WithNetSerializer = true };
+};
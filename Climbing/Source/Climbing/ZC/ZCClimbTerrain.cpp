@@ -0,0 +1,293 @@
+#include "Climbing/ZC/ZCClimbTerrain.h"
+#include "Climbing/Climbing.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "UObject/ConstructorHelpers.h"
+
+// The engine cube is 100 units across and centred on its origin
+static constexpr float CubeSize = 100.f;
+
+// How far in front of a climbable face a climb start is, so a standing capsule fits without touching it
+static constexpr float ClimbStartOffset = 60.f;
+
+AZCClimbTerrain::AZCClimbTerrain()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Boxes = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Boxes"));
+	Boxes->SetMobility(EComponentMobility::Static);
+	Boxes->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	RootComponent = Boxes;
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (CubeMesh.Succeeded())
+		Boxes->SetStaticMesh(CubeMesh.Object);
+}
+
+AZCClimbTerrain* AZCClimbTerrain::SpawnClimbTerrain(UWorld* World, const FZCClimbTerrainSettings& InSettings)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.bDeferConstruction = true;
+
+	AZCClimbTerrain* Terrain = World->SpawnActor<AZCClimbTerrain>(StaticClass(), FTransform::Identity, SpawnParams);
+	if (!Terrain)
+		return nullptr;
+
+	Terrain->Settings = InSettings;
+	Terrain->FinishSpawning(FTransform::Identity);
+	Terrain->Generate();
+
+	return Terrain;
+}
+
+AZCClimbTerrain* AZCClimbTerrain::SpawnBenchmarkWall(UWorld* World, const FVector2D& FaceSize, FVector& OutFaceCenter)
+{
+	const FVector Location(0.f, 0.f, 600000.f);
+
+	AZCClimbTerrain* Terrain = World->SpawnActor<AZCClimbTerrain>(StaticClass(), FTransform(Location));
+	if (!Terrain)
+		return nullptr;
+
+	Terrain->AddBox(FVector::ZeroVector, FRotator::ZeroRotator, FVector(CubeSize, FaceSize.X, FaceSize.Y));
+	Terrain->AddClimbStart(FVector(-CubeSize * 0.5f, 0.f, -FaceSize.Y * 0.5f), FVector::BackwardVector);
+	Terrain->CommitBoxes();
+
+	OutFaceCenter = Location - FVector(CubeSize * 0.5f, 0.f, 0.f);
+	return Terrain;
+}
+
+void AZCClimbTerrain::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	if (bGenerateOnConstruction)
+		Generate();
+}
+
+void AZCClimbTerrain::Generate()
+{
+	Clear();
+
+	// A stream per kind of feature, so the count of one doesn't shift the layout of the others
+	FRandomStream WallRandom(HashCombine(GetTypeHash(Settings.Seed), 1));
+	FRandomStream OverhangRandom(HashCombine(GetTypeHash(Settings.Seed), 2));
+	FRandomStream LedgeRandom(HashCombine(GetTypeHash(Settings.Seed), 3));
+	FRandomStream StairRandom(HashCombine(GetTypeHash(Settings.Seed), 4));
+	FRandomStream LandscapeRandom(HashCombine(GetTypeHash(Settings.Seed), 5));
+
+	if (Settings.bGround)
+		AddBox(FVector(0.f, 0.f, -CubeSize * 0.5f), FRotator::ZeroRotator, FVector(Settings.FieldSize, Settings.FieldSize, CubeSize));
+
+	GenerateWalls(WallRandom);
+	GenerateOverhangs(OverhangRandom);
+	GenerateLedges(LedgeRandom);
+	GenerateStairs(StairRandom);
+	GenerateLandscapePatches(LandscapeRandom);
+
+	// One batch, so the render and physics state are only rebuilt once
+	CommitBoxes();
+}
+
+void AZCClimbTerrain::Clear()
+{
+	Boxes->ClearInstances();
+	ClimbStarts.Reset();
+	PendingInstances.Reset();
+}
+
+int32 AZCClimbTerrain::GetNumPrimitives() const
+{
+	return Boxes->GetInstanceCount();
+}
+
+void AZCClimbTerrain::AddBox(const FVector& Center, const FRotator& Rotation, const FVector& Size)
+{
+	PendingInstances.Add(FTransform(Rotation, Center, Size / CubeSize));
+}
+
+void AZCClimbTerrain::CommitBoxes()
+{
+	Boxes->AddInstances(PendingInstances, false);
+	PendingInstances.Empty();
+}
+
+void AZCClimbTerrain::AddClimbStart(const FVector& FaceBase, const FVector& FaceNormal)
+{
+	const FVector Normal = FaceNormal.GetSafeNormal2D();
+	const FVector Location = FaceBase + Normal * ClimbStartOffset + FVector(0.f, 0.f, 100.f);
+	ClimbStarts.Add(FTransform((-Normal).Rotation(), Location) * GetActorTransform());
+}
+
+FVector AZCClimbTerrain::RandomFieldLocation(FRandomStream& Random) const
+{
+	const float HalfSize = Settings.FieldSize * 0.45f;
+	return FVector(Random.FRandRange(-HalfSize, HalfSize), Random.FRandRange(-HalfSize, HalfSize), 0.f);
+}
+
+int32 AZCClimbTerrain::Scaled(int32 Count) const
+{
+	return FMath::RoundToInt(Count * Settings.Density);
+}
+
+void AZCClimbTerrain::GenerateWalls(FRandomStream& Random)
+{
+	constexpr float Thickness = 50.f;
+
+	// Box X is the wall's thickness, its -X face is the one that gets climbed
+	for (int32 Wall = 0; Wall < Scaled(Settings.NumWalls); ++Wall)
+	{
+		const FVector Base = RandomFieldLocation(Random);
+		const FRotator Rotation(Random.FRandRange(-Settings.MaxWallTilt, Settings.MaxWallTilt), Random.FRandRange(0.f, 360.f), 0.f);
+		const FVector Size(Thickness, Random.FRandRange(Settings.WallWidthRange.X, Settings.WallWidthRange.Y), Random.FRandRange(Settings.WallHeightRange.X, Settings.WallHeightRange.Y));
+
+		AddBox(Base + Rotation.RotateVector(FVector(0.f, 0.f, Size.Z * 0.5f)), Rotation, Size);
+		AddClimbStart(Base - Rotation.RotateVector(FVector::ForwardVector) * Thickness * 0.5f, -Rotation.RotateVector(FVector::ForwardVector));
+	}
+}
+
+void AZCClimbTerrain::GenerateOverhangs(FRandomStream& Random)
+{
+	constexpr float Thickness = 50.f;
+	constexpr float RoofThickness = 30.f;
+
+	for (int32 Overhang = 0; Overhang < Scaled(Settings.NumOverhangs); ++Overhang)
+	{
+		const FVector Base = RandomFieldLocation(Random);
+		const float Yaw = Random.FRandRange(0.f, 360.f);
+
+		// Positive pitch leans the top out over the -X side, where the climber is
+		const FRotator Rotation(Random.FRandRange(Settings.OverhangAngleRange.X, Settings.OverhangAngleRange.Y), Yaw, 0.f);
+		const FVector Size(Thickness, Random.FRandRange(Settings.WallWidthRange.X, Settings.WallWidthRange.Y), Random.FRandRange(Settings.WallHeightRange.X, Settings.WallHeightRange.Y));
+		AddBox(Base + Rotation.RotateVector(FVector(0.f, 0.f, Size.Z * 0.5f)), Rotation, Size);
+
+		// Flat roof from the top of the wall back out over the climber
+		const FRotator RoofRotation(0.f, Yaw, 0.f);
+		const FVector Forward = RoofRotation.Vector();
+		const FVector Top = Base + Rotation.RotateVector(FVector(0.f, 0.f, Size.Z));
+		const float RoofDepth = Random.FRandRange(Settings.RoofDepthRange.X, Settings.RoofDepthRange.Y);
+		AddBox(Top - Forward * RoofDepth * 0.5f + FVector(0.f, 0.f, RoofThickness * 0.5f), RoofRotation, FVector(RoofDepth + Thickness, Size.Y, RoofThickness));
+
+		AddClimbStart(Base - Forward * Thickness * 0.5f, -Forward);
+	}
+}
+
+void AZCClimbTerrain::GenerateLedges(FRandomStream& Random)
+{
+	constexpr float LipThickness = 20.f;
+
+	for (int32 Ledge = 0; Ledge < Scaled(Settings.NumLedges); ++Ledge)
+	{
+		const FVector Base = RandomFieldLocation(Random);
+		const FRotator Rotation(0.f, Random.FRandRange(0.f, 360.f), 0.f);
+		const FVector Forward = Rotation.Vector();
+
+		// Deep enough to stand on top of
+		const FVector Size(Random.FRandRange(200.f, 400.f), Random.FRandRange(Settings.WallWidthRange.X, Settings.WallWidthRange.Y), Random.FRandRange(Settings.LedgeHeightRange.X, Settings.LedgeHeightRange.Y));
+		AddBox(Base + Forward * Size.X * 0.5f + FVector(0.f, 0.f, Size.Z * 0.5f), Rotation, Size);
+
+		const float LipDepth = Random.FRandRange(Settings.LipDepthRange.X, Settings.LipDepthRange.Y);
+		if (LipDepth >= 1.f)
+			AddBox(Base - Forward * (LipDepth - LipThickness) * 0.5f + FVector(0.f, 0.f, Size.Z - LipThickness * 0.5f), Rotation, FVector(LipDepth + LipThickness, Size.Y, LipThickness));
+
+		AddClimbStart(Base, -Forward);
+	}
+}
+
+void AZCClimbTerrain::GenerateStairs(FRandomStream& Random)
+{
+	for (int32 Stair = 0; Stair < Scaled(Settings.NumStairs); ++Stair)
+	{
+		const FVector Base = RandomFieldLocation(Random);
+		const FRotator Rotation(0.f, Random.FRandRange(0.f, 360.f), 0.f);
+		const FVector Forward = Rotation.Vector();
+
+		const int32 NumSteps = Random.RandRange(Settings.StepCountRange.X, Settings.StepCountRange.Y);
+		const float Rise = Random.FRandRange(Settings.StepRiseRange.X, Settings.StepRiseRange.Y);
+		const float Run = Random.FRandRange(Settings.StepRunRange.X, Settings.StepRunRange.Y);
+		const float Width = Random.FRandRange(200.f, 400.f);
+
+		// Solid steps down to the ground, so the back of the flight is a wall to climb down onto the steps from
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			const float Height = Rise * (Step + 1);
+			AddBox(Base + Forward * Run * (Step + 0.5f) + FVector(0.f, 0.f, Height * 0.5f), Rotation, FVector(Run, Width, Height));
+		}
+
+		AddClimbStart(Base + Forward * Run * NumSteps, Forward);
+	}
+}
+
+void AZCClimbTerrain::GenerateLandscapePatches(FRandomStream& Random)
+{
+	const int32 Resolution = Settings.PatchResolution;
+	const float CellSize = Settings.PatchCellSize;
+
+	for (int32 Patch = 0; Patch < Scaled(Settings.NumLandscapePatches); ++Patch)
+	{
+		const FVector Origin = RandomFieldLocation(Random) - FVector(Resolution * CellSize * 0.5f, Resolution * CellSize * 0.5f, 0.f);
+		const FVector2D NoiseOffset(Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f));
+		AddLandscapePatch(Origin, Resolution, CellSize, Settings.PatchHeight, NoiseOffset);
+	}
+}
+
+void AZCClimbTerrain::AddLandscapePatch(const FVector& Origin, int32 Resolution, float CellSize, float Height, const FVector2D& NoiseOffset)
+{
+	// Noise features a few cells across
+	const float Frequency = 1.f / (CellSize * 4.f);
+
+	auto HeightAt = [&](float X, float Y)
+	{
+		return Height * 0.5f * (FMath::PerlinNoise2D(FVector2D(X, Y) * Frequency + NoiseOffset) + 1.f);
+	};
+
+	for (int32 CellX = 0; CellX < Resolution; ++CellX)
+		for (int32 CellY = 0; CellY < Resolution; ++CellY)
+		{
+			const float X = CellX * CellSize;
+			const float Y = CellY * CellSize;
+
+			// Top of each cell is the plane through its corner heights
+			const float Height00 = HeightAt(X, Y);
+			const float Height10 = HeightAt(X + CellSize, Y);
+			const float Height01 = HeightAt(X, Y + CellSize);
+			const float Height11 = HeightAt(X + CellSize, Y + CellSize);
+			const float CenterHeight = (Height00 + Height10 + Height01 + Height11) * 0.25f;
+
+			const FVector SlopeX(CellSize, 0.f, (Height10 + Height11 - Height00 - Height01) * 0.5f);
+			const FVector SlopeY(0.f, CellSize, (Height01 + Height11 - Height00 - Height10) * 0.5f);
+			const FVector Normal = (SlopeX ^ SlopeY).GetSafeNormal();
+			const FRotator Rotation = FRotationMatrix::MakeFromZX(Normal, SlopeX).Rotator();
+
+			// Reaches below the ground so there are no gaps under steep cells. A little oversized to close the seams between them.
+			const float Depth = CenterHeight + CubeSize;
+			const FVector Top = Origin + FVector(X + CellSize * 0.5f, Y + CellSize * 0.5f, CenterHeight);
+			AddBox(Top - Normal * Depth * 0.5f, Rotation, FVector(CellSize * 1.05f, CellSize * 1.05f, Depth));
+		}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ClimbTerrainGenerateCommand(
+	TEXT("ZC.Terrain.Generate"),
+	TEXT("Generates climbing test terrain at the world origin, replacing any generated before\n")
+	TEXT("Usage: ZC.Terrain.Generate [Seed=1] [Density=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+			return;
+
+		for (TActorIterator<AZCClimbTerrain> It(World); It; ++It)
+			It->Destroy();
+
+		FZCClimbTerrainSettings Settings;
+		Settings.Seed = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1;
+		Settings.Density = Args.Num() > 1 ? FMath::Max(0.f, FCString::Atof(*Args[1])) : 1.f;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const AZCClimbTerrain* Terrain = AZCClimbTerrain::SpawnClimbTerrain(World, Settings);
+		if (Terrain)
+			UE_LOG(LogZCClimbing, Display, TEXT("ZC.Terrain.Generate: %d boxes, %d climb starts in %.1f ms"),
+				Terrain->GetNumPrimitives(), Terrain->GetClimbStarts().Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}));
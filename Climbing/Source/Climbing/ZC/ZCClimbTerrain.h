@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ZCClimbTerrain.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * What to generate and how much of it. Every kind of feature draws from its own random stream derived from Seed,
+ * so changing how many of one kind there are leaves the others where they were.
+ */
+USTRUCT(BlueprintType)
+struct FZCClimbTerrainSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing")
+	int32 Seed = 1;
+
+	// Side of the square area features are placed in, centred on the actor
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing", meta = (ClampMin = "1000.0"))
+	float FieldSize = 10000.f;
+
+	// Flat ground under the whole field
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing")
+	bool bGround = true;
+
+	// Free standing walls at random yaw, leaning up to MaxWallTilt degrees either way from vertical
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Walls", meta = (ClampMin = "0"))
+	int32 NumWalls = 40;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Walls", meta = (ClampMin = "0.0", ClampMax = "60.0"))
+	float MaxWallTilt = 20.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Walls")
+	FVector2D WallWidthRange = FVector2D(300.f, 1200.f);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Walls")
+	FVector2D WallHeightRange = FVector2D(300.f, 1500.f);
+
+	// Walls leaning out over the climber, topped with a roof slab
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Overhangs", meta = (ClampMin = "0"))
+	int32 NumOverhangs = 10;
+	// Degrees past vertical
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Overhangs")
+	FVector2D OverhangAngleRange = FVector2D(5.f, 35.f);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Overhangs")
+	FVector2D RoofDepthRange = FVector2D(50.f, 300.f);
+
+	// Deep blocks with a walkable top, and a lip sticking out over the climbing face
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Ledges", meta = (ClampMin = "0"))
+	int32 NumLedges = 20;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Ledges")
+	FVector2D LedgeHeightRange = FVector2D(150.f, 800.f);
+	// A depth of 0 is a plain edge
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Ledges")
+	FVector2D LipDepthRange = FVector2D(0.f, 60.f);
+
+	// Flights of steps climbers can land on and climb down to
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Stairs", meta = (ClampMin = "0"))
+	int32 NumStairs = 10;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Stairs")
+	FIntPoint StepCountRange = FIntPoint(4, 16);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Stairs")
+	FVector2D StepRiseRange = FVector2D(15.f, 60.f);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Stairs")
+	FVector2D StepRunRange = FVector2D(30.f, 120.f);
+
+	// Uneven ground made of boxes tilted to follow a noise heightfield
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Landscape", meta = (ClampMin = "0"))
+	int32 NumLandscapePatches = 4;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Landscape", meta = (ClampMin = "2", ClampMax = "256"))
+	int32 PatchResolution = 16;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Landscape", meta = (ClampMin = "10.0"))
+	float PatchCellSize = 100.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing|Landscape")
+	float PatchHeight = 400.f;
+
+	// Multiplies every feature count, for scaling a layout up or down without changing its mix
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climbing", meta = (ClampMin = "0.0"))
+	float Density = 1.f;
+};
+
+/**
+ * Generated climbing test terrain. Everything is a box instance on one static instanced mesh component, so it scales to tens of
+ * thousands of primitives, and the same settings always generate the same terrain. Works in the editor, in game and in commandlets.
+ */
+UCLASS()
+class CLIMBING_API AZCClimbTerrain : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AZCClimbTerrain();
+
+	// Spawns terrain generated from Settings at the world origin
+	static AZCClimbTerrain* SpawnClimbTerrain(UWorld* World, const FZCClimbTerrainSettings& InSettings);
+	// Spawns a single flat wall well out of the way of the level for benchmarks. Its climbable face looks down -X, FaceSize is its width and height.
+	static AZCClimbTerrain* SpawnBenchmarkWall(UWorld* World, const FVector2D& FaceSize, FVector& OutFaceCenter);
+
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Climbing")
+	void Generate();
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Climbing")
+	void Clear();
+
+	// Hand placed boxes, for tests that need a particular shape. Sizes are in world units, nothing collides until CommitBoxes.
+	void AddBox(const FVector& Center, const FRotator& Rotation, const FVector& Size);
+	// Resolution by Resolution cells of uneven ground from Origin along +X and +Y, up to Height above it. NoiseOffset picks the part of the noise it follows.
+	void AddLandscapePatch(const FVector& Origin, int32 Resolution, float CellSize, float Height, const FVector2D& NoiseOffset);
+	void CommitBoxes();
+
+	void SetSettings(const FZCClimbTerrainSettings& InSettings) { Settings = InSettings; }
+	int32 GetNumPrimitives() const;
+
+	// Standing spots in front of climbable faces, looking at them, in world space
+	const TArray<FTransform>& GetClimbStarts() const { return ClimbStarts; }
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+protected:
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	FZCClimbTerrainSettings Settings;
+
+	// Regenerates whenever the actor is constructed, e.g. on every settings change in the editor
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	bool bGenerateOnConstruction = false;
+
+	UPROPERTY(Category = "Climbing", VisibleAnywhere)
+	UInstancedStaticMeshComponent* Boxes;
+
+	UPROPERTY()
+	TArray<FTransform> ClimbStarts;
+
+private:
+	void AddClimbStart(const FVector& FaceBase, const FVector& FaceNormal);
+	FVector RandomFieldLocation(FRandomStream& Random) const;
+	int32 Scaled(int32 Count) const;
+
+	void GenerateWalls(FRandomStream& Random);
+	void GenerateOverhangs(FRandomStream& Random);
+	void GenerateLedges(FRandomStream& Random);
+	void GenerateStairs(FRandomStream& Random);
+	void GenerateLandscapePatches(FRandomStream& Random);
+
+	TArray<FTransform> PendingInstances;
+};
@@ -0,0 +1,40 @@
+#include "Climbing/ZC/ZCClimbValidation.h"
+
+#include "Components/PrimitiveComponent.h"
+
+void FZCRecentSurfaceCache::Add(const FVector& Position, const FVector& Normal, const UPrimitiveComponent* Component, double Time)
+{
+	if (!Component)
+		return;
+
+	const FSample Sample = { Position, Normal, Component, Component->GetComponentLocation(), Time };
+	if (Samples.Num() < MaxSamples)
+	{
+		Samples.Add(Sample);
+		return;
+	}
+
+	Samples[NextSample] = Sample;
+	NextSample = (NextSample + 1) % MaxSamples;
+}
+
+void FZCRecentSurfaceCache::Reset()
+{
+	Samples.Reset();
+	NextSample = 0;
+}
+
+bool FZCRecentSurfaceCache::Confirms(const FZCClimbContactClaim& Claim, double Time, float MaxAge, float MaxDistance, float MinNormalCos) const
+{
+	for (const FSample& Sample : Samples)
+	{
+		if (Time - Sample.Time > MaxAge || FVector::DistSquared(Sample.Position, Claim.Position) > FMath::Square(MaxDistance) || (Sample.Normal | Claim.Normal) < MinNormalCos)
+			continue;
+
+		const UPrimitiveComponent* Component = Sample.Component.Get();
+		if (Component && Component->GetComponentLocation().Equals(Sample.ComponentLocation, 1.f))
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+// The wall contact a client decided to start climbing on, sent with the move so the server can check that instead of probing
+struct FZCClimbContactClaim
+{
+	FVector Position = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+};
+
+/**
+ * Surface points the server's own probes found around a character in the last moment. A claim that lands on one of them is confirmed
+ * without a query. Fixed size, the oldest samples are overwritten first.
+ */
+struct FZCRecentSurfaceCache
+{
+	static constexpr int32 MaxSamples = 32;
+
+	void Add(const FVector& Position, const FVector& Normal, const UPrimitiveComponent* Component, double Time);
+	void Reset();
+
+	// Whether a sample no older than MaxAge and no further than MaxDistance from the claim, on a component that hasn't moved since, agrees with its normal
+	bool Confirms(const FZCClimbContactClaim& Claim, double Time, float MaxAge, float MaxDistance, float MinNormalCos) const;
+
+private:
+	struct FSample
+	{
+		FVector Position;
+		FVector Normal;
+		TWeakObjectPtr<const UPrimitiveComponent> Component;
+		// Where the component was when the sample was taken, so samples on anything that moved since are ignored
+		FVector ComponentLocation;
+		double Time;
+	};
+
+	TArray<FSample, TFixedAllocator<MaxSamples>> Samples;
+	int32 NextSample = 0;
+};
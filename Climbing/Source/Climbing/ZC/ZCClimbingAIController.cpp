@@ -0,0 +1,7 @@
+#include "Climbing/ZC/ZCClimbingAIController.h"
+#include "Climbing/ZC/ZCClimbPathFollowingComponent.h"
+
+AZCClimbingAIController::AZCClimbingAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UZCClimbPathFollowingComponent>(TEXT("PathFollowingComponent")))
+{
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "ZCClimbingAIController.generated.h"
+
+/**
+ * AI controller that can follow paths up climb links
+ */
+UCLASS()
+class CLIMBING_API AZCClimbingAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AZCClimbingAIController(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,26 @@
+#include "Climbing/ZC/ZCClimbingAnimInstance.h"
+
+#include "GameFramework/Character.h"
+
+void FZCClimbingAnimInstanceProxy::InitializeObjects(UAnimInstance* InAnimInstance)
+{
+	Super::InitializeObjects(InAnimInstance);
+
+	const ACharacter* Character = Cast<ACharacter>(InAnimInstance->TryGetPawnOwner());
+	MovementComponent = Character ? Cast<UZCCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+}
+
+void FZCClimbingAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// Game thread, after the movement component has ticked and published this frame's state
+	ClimbingAnimState = MovementComponent ? MovementComponent->GetClimbingAnimState() : FZCClimbingAnimState();
+}
+
+void FZCClimbingAnimInstanceProxy::ClearObjects()
+{
+	Super::ClearObjects();
+
+	MovementComponent = nullptr;
+}
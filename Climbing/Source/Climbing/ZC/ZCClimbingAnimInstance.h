@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "ZCClimbingAnimInstance.generated.h"
+
+// Copies the movement component's climbing state on the game thread before each update, so the graph never touches the component
+USTRUCT()
+struct FZCClimbingAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FZCClimbingAnimInstanceProxy() {}
+	FZCClimbingAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+	virtual void InitializeObjects(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void ClearObjects() override;
+
+	const FZCClimbingAnimState& GetClimbingAnimState() const { return ClimbingAnimState; }
+
+private:
+	UZCCharacterMovementComponent* MovementComponent = nullptr;
+	FZCClimbingAnimState ClimbingAnimState;
+};
+
+/**
+ * Base class for climbing animation blueprints. The climbing state is read through the thread safe accessors here instead of calling
+ * into UZCCharacterMovementComponent from the event graph, which lets the whole update run on a worker thread.
+ */
+UCLASS(Transient, Blueprintable)
+class CLIMBING_API UZCClimbingAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	FZCClimbingAnimState GetClimbingAnimState() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState(); }
+
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	bool IsClimbing() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState().bIsClimbing; }
+
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	bool IsClimbDashing() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState().bIsClimbDashing; }
+
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	bool IsLedgeClimbing() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState().bIsLedgeClimbing; }
+
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	FVector GetClimbDashDirection() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState().ClimbDashDirection; }
+
+	UFUNCTION(BlueprintPure, Category = "Climbing", meta = (BlueprintThreadSafe))
+	FVector GetClimbSurfaceNormal() const { return GetProxyOnAnyThread<FZCClimbingAnimInstanceProxy>().GetClimbingAnimState().ClimbSurfaceNormal; }
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+private:
+	UPROPERTY(Transient)
+	FZCClimbingAnimInstanceProxy Proxy;
+};
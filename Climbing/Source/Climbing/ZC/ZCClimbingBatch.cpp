@@ -0,0 +1,238 @@
+#include "Climbing/ZC/ZCClimbingBatch.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbTerrain.h"
+#include "Climbing/ZC/ZCTypes.h"
+#include "Climbing/Climbing.h"
+
+#include "Async/ParallelFor.h"
+#include "GameFramework/GameModeBase.h"
+
+static TAutoConsoleVariable<bool> CVarClimbingBatchSingleThread(
+	TEXT("ZC.Batch.ForceSingleThread"),
+	false,
+	TEXT("Runs the batched climbing queries on the game thread, one climber after another"),
+	ECVF_Default);
+
+void FZCClimbingBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+		Subsystem->RunBatch();
+}
+
+void UZCClimbingBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	BatchTickFunction.Subsystem = this;
+	BatchTickFunction.bCanEverTick = true;
+	BatchTickFunction.bRunOnAnyThread = false;
+	BatchTickFunction.TickGroup = TG_PrePhysics;
+	BatchTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UZCClimbingBatchSubsystem::Deinitialize()
+{
+	if (BatchTickFunction.IsTickFunctionRegistered())
+		BatchTickFunction.UnRegisterTickFunction();
+
+	Climbers.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UZCClimbingBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UZCClimbingBatchSubsystem::RegisterClimber(UZCCharacterMovementComponent* Climber)
+{
+	if (Climbers.Contains(Climber))
+		return;
+
+	// The batch runs once every climber has moved for the frame
+	Climbers.Add(Climber);
+	BatchTickFunction.AddPrerequisite(Climber, Climber->PrimaryComponentTick);
+}
+
+void UZCClimbingBatchSubsystem::UnregisterClimber(UZCCharacterMovementComponent* Climber)
+{
+	if (Climbers.Remove(Climber) > 0)
+		BatchTickFunction.RemovePrerequisite(Climber, Climber->PrimaryComponentTick);
+}
+
+void UZCClimbingBatchSubsystem::RunBatch(int32 NumTasks)
+{
+	Climbers.RemoveAll([](const UZCCharacterMovementComponent* Climber) { return !IsValid(Climber); });
+	if (Climbers.IsEmpty())
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ZCBatchQueries);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("ZCClimbing::Batch", ZCClimbingChannel);
+
+	const int32 NumClimbers = Climbers.Num();
+	const int32 Tasks = NumTasks > 0 ? FMath::Min(NumTasks, NumClimbers) : NumClimbers;
+	const int32 ClimbersPerTask = FMath::DivideAndRoundUp(NumClimbers, Tasks);
+	const EParallelForFlags Flags = CVarClimbingBatchSingleThread.GetValueOnGameThread() ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+	ParallelFor(Tasks, [this, NumClimbers, ClimbersPerTask](int32 Task)
+	{
+		const int32 End = FMath::Min(NumClimbers, (Task + 1) * ClimbersPerTask);
+		for (int32 Index = Task * ClimbersPerTask; Index < End; ++Index)
+			Climbers[Index]->RunBatchedClimbingQueries();
+	}, Flags);
+
+	// Anything that has to be on the game thread
+	for (UZCCharacterMovementComponent* Climber : Climbers)
+		Climber->FinishBatchedClimbingQueries();
+}
+
+void UZCClimbingBatchSubsystem::RunBenchmark(int32 NumClimbers, int32 NumFrames)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	// Use the game's climbing character if it has one so the tuning matches
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	UClass* CharacterClass = GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<AZCClimbingCharacter>()
+		? GameMode->DefaultPawnClass.Get()
+		: AZCClimbingCharacter::StaticClass();
+
+	FVector WallFace;
+	AZCClimbTerrain* Wall = AZCClimbTerrain::SpawnBenchmarkWall(World, FVector2D(40000.f, 10000.f), WallFace);
+	if (!Wall)
+		return;
+
+	// Benchmark only the generated climbers
+	TArray<UZCCharacterMovementComponent*> LevelClimbers = MoveTemp(Climbers);
+	Climbers.Reset();
+
+	const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumClimbers)));
+	TArray<AActor*> Spawned;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 ClimberIndex = 0; ClimberIndex < NumClimbers; ++ClimberIndex)
+	{
+		const float Y = ((ClimberIndex % Columns) - Columns / 2) * 150.f;
+		const float Z = ((ClimberIndex / Columns) - Columns / 2) * 250.f;
+
+		AZCClimbingCharacter* Character = World->SpawnActor<AZCClimbingCharacter>(CharacterClass, WallFace + FVector(-45.f, Y, Z), FRotator::ZeroRotator, SpawnParams);
+		UZCCharacterMovementComponent* Movement = Character ? Character->GetZCMovementComponent() : nullptr;
+		if (!Movement)
+			continue;
+
+		Spawned.Add(Character);
+		Movement->SetMovementMode(MOVE_Custom, ECustomMovementMode::CMOVE_Climbing);
+		Climbers.Add(Movement);
+	}
+
+	struct FClimberResult
+	{
+		FVector Normal;
+		FVector Position;
+		int32 NumWallContacts;
+
+		bool operator==(const FClimberResult& Other) const { return Normal == Other.Normal && Position == Other.Position && NumWallContacts == Other.NumWallContacts; }
+	};
+
+	auto CaptureResults = [this]()
+	{
+		TArray<FClimberResult> Results;
+		for (const UZCCharacterMovementComponent* Climber : Climbers)
+			Results.Add({ Climber->BatchedClimbingNormal, Climber->BatchedClimbingPosition, Climber->CurrentWallContacts.Num() });
+		return Results;
+	};
+
+	// Every run has to do the queries for real rather than answer them from the per tick cache
+	auto RunUncached = [this](int32 Tasks)
+	{
+		for (UZCCharacterMovementComponent* Climber : Climbers)
+			Climber->QueryCache.Reset();
+		RunBatch(Tasks);
+	};
+
+	// Every climber wanders over the wall along its own path, the same one on every run, so each run is compared to the serial one frame by frame
+	TArray<FTransform> StartTransforms;
+	for (const UZCCharacterMovementComponent* Climber : Climbers)
+		StartTransforms.Add(Climber->UpdatedComponent->GetComponentTransform());
+
+	auto MoveClimbers = [&](int32 Frame)
+	{
+		for (int32 Index = 0; Index < Climbers.Num(); ++Index)
+		{
+			const float Phase = Index * 0.7f + Frame * 0.05f;
+			const FVector Offset(FMath::Sin(Phase * 1.3f) * 10.f, FMath::Sin(Phase) * 50.f, FMath::Cos(Phase * 0.8f) * 80.f);
+			const FRotator Rotation = StartTransforms[Index].Rotator() + FRotator(0.f, FMath::Sin(Phase * 0.6f) * 15.f, 0.f);
+			Climbers[Index]->UpdatedComponent->SetWorldLocationAndRotation(StartTransforms[Index].GetLocation() + Offset, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	};
+
+	// Starts from the first frame's sweep, so every run begins with the same walls found
+	auto RewindClimbers = [&]()
+	{
+		MoveClimbers(0);
+		RunUncached(1);
+	};
+
+	TArray<TArray<FClimberResult>> SerialResults;
+	SerialResults.Reserve(NumFrames);
+	RewindClimbers();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		MoveClimbers(Frame);
+		RunUncached(1);
+		SerialResults.Add(CaptureResults());
+	}
+
+	UE_LOG(LogZCClimbing, Display, TEXT("Batched climbing: %d climbers, %d frames, %d task graph workers"), Climbers.Num(), NumFrames, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	double SingleTaskMs = 0.0;
+	for (const int32 Tasks : { 1, 2, 4, 8, 16 })
+	{
+		bool bMatchesSerial = true;
+		double TotalSeconds = 0.0;
+
+		RewindClimbers();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			MoveClimbers(Frame);
+
+			const double StartTime = FPlatformTime::Seconds();
+			RunUncached(Tasks);
+			TotalSeconds += FPlatformTime::Seconds() - StartTime;
+
+			bMatchesSerial &= CaptureResults() == SerialResults[Frame];
+		}
+		const double FrameMs = TotalSeconds * 1000.0 / NumFrames;
+
+		if (Tasks == 1)
+			SingleTaskMs = FrameMs;
+
+		UE_LOG(LogZCClimbing, Display, TEXT("    %2d tasks: %.3f ms/frame, %.2fx, %s"), Tasks, FrameMs, FrameMs > 0.0 ? SingleTaskMs / FrameMs : 0.0, bMatchesSerial ? TEXT("matches serial") : TEXT("DIFFERS FROM SERIAL"));
+	}
+
+	for (AActor* Actor : Spawned)
+		Actor->Destroy();
+	Wall->Destroy();
+
+	Climbers = MoveTemp(LevelClimbers);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ClimbingBatchBenchmarkCommand(
+	TEXT("ZC.Batch.Benchmark"),
+	TEXT("Times the batched climbing queries from 1 to 16 tasks for climbers moving over a generated wall, and checks every frame matches a serial run.\n")
+	TEXT("Usage: ZC.Batch.Benchmark [NumClimbers=40] [NumFrames=300]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UZCClimbingBatchSubsystem* Batch = World ? World->GetSubsystem<UZCClimbingBatchSubsystem>() : nullptr;
+		if (!Batch)
+			return;
+
+		const int32 NumClimbers = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 40;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 300;
+		Batch->RunBenchmark(NumClimbers, NumFrames);
+	}));
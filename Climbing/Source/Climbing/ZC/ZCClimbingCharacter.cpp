@@ -1,6 +1,7 @@
 
 #include "Climbing/ZC/ZCClimbingCharacter.h"
 #include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbReplay.h"
 
 #include "EnhancedInputComponent.h"
 
@@ -24,6 +25,9 @@ void AZCClimbingCharacter::Move(const FInputActionValue& Value)
 	// input is a Vector2D
 	FVector2D MovementVector = Value.Get<FVector2D>();
 
+	if (ClimbReplay && !ClimbReplay->HandleMoveInput(MovementVector))
+		return;
+
 	if (Controller != nullptr)
 	{
 		if (MovementComponent && MovementComponent->IsClimbing())
@@ -55,22 +59,52 @@ void AZCClimbingCharacter::Move(const FInputActionValue& Value)
 
 void AZCClimbingCharacter::Climb(const FInputActionValue& Value)
 {
+	if (ClimbReplay && !ClimbReplay->HandleActionInput(EZCClimbInputAction::Climb))
+		return;
+
 	if (MovementComponent)
 		MovementComponent->WantsClimbing();
 }
 
 void AZCClimbingCharacter::CancelClimb(const FInputActionValue& Value)
 {
+	if (ClimbReplay && !ClimbReplay->HandleActionInput(EZCClimbInputAction::CancelClimb))
+		return;
+
 	if (MovementComponent)
 		MovementComponent->CancelClimbing();
 }
 
 void AZCClimbingCharacter::ClimbDash(const FInputActionValue& Value)
 {
+	if (ClimbReplay && !ClimbReplay->HandleActionInput(EZCClimbInputAction::ClimbDash))
+		return;
+
 	if (MovementComponent)
 		MovementComponent->TryClimbDashing();
 }
 
+void AZCClimbingCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	// Headless runs start a replay straight from the command line, e.g. -nullrhi -ZCReplay=MyRun
+	FString ReplayName;
+	if (IsPlayerControlled() && FParse::Value(FCommandLine::Get(), TEXT("ZCReplay="), ReplayName))
+		GetOrCreateClimbReplay()->StartReplay(ReplayName, true);
+}
+
+UZCClimbReplayComponent* AZCClimbingCharacter::GetOrCreateClimbReplay()
+{
+	if (!ClimbReplay)
+	{
+		ClimbReplay = NewObject<UZCClimbReplayComponent>(this, TEXT("ClimbReplay"));
+		ClimbReplay->RegisterComponent();
+	}
+
+	return ClimbReplay;
+}
+
 void AZCClimbingCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
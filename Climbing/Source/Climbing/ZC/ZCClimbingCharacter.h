@@ -14,15 +14,29 @@ class CLIMBING_API AZCClimbingCharacter : public AClimbingCharacter
 {
 	GENERATED_BODY()
 
+	// Replays drive the character through the same input handlers
+	friend class UZCClimbReplayComponent;
+	// So does AI following a path up a climb link
+	friend class UZCClimbPathFollowingComponent;
+	// And the headless stress test
+	friend class UZCClimbBenchmarkCommandlet;
+#if WITH_DEV_AUTOMATION_TESTS
+	// And the automation tests
+	friend class FZCClimbingTestWorld;
+#endif
+
 public:
 	AZCClimbingCharacter(const FObjectInitializer&);
 	virtual ~AZCClimbingCharacter(){}
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	virtual void PossessedBy(AController* NewController) override;
 
 	UFUNCTION(BlueprintPure)
 	class UZCCharacterMovementComponent* GetZCMovementComponent() const { return MovementComponent; }
 
+	class UZCClimbReplayComponent* GetOrCreateClimbReplay();
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	class UInputAction* ClimbAction;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
@@ -41,4 +55,8 @@ protected:
 
 	UPROPERTY(Category = Character, VisibleAnywhere, BlueprintReadOnly)
 	class UZCCharacterMovementComponent* MovementComponent;
+
+	// Only created when recording or replaying input
+	UPROPERTY(Transient)
+	class UZCClimbReplayComponent* ClimbReplay;
 };
@@ -0,0 +1,308 @@
+#include "Climbing/ZC/ZCClimbingCrowd.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbMotionProfile.h"
+#include "Climbing/ZC/ZCClimbTerrain.h"
+#include "Climbing/ZC/ZCTypes.h"
+#include "Climbing/Climbing.h"
+
+#include "Async/ParallelFor.h"
+#include "Curves/CurveFloat.h"
+
+int32 FZCCrowdClimbers::Add(const FVector& Position, const FVector& Normal)
+{
+	Positions.Add(Position);
+	Normals.Add(Normal);
+	Velocities.Add(FVector::ZeroVector);
+	MoveInputs.Add(FVector2D::ZeroVector);
+	DashDirections.Add(FVector::ZeroVector);
+	DashTimes.Add(-1.f);
+	bAttached.Add(1);
+
+	SurfacePoints.AddZeroed();
+	SurfaceNormals.AddZeroed();
+	bSurfaceHits.AddZeroed();
+
+	return Positions.Num() - 1;
+}
+
+void FZCCrowdClimbers::RemoveAtSwap(int32 Index)
+{
+	Positions.RemoveAtSwap(Index);
+	Normals.RemoveAtSwap(Index);
+	Velocities.RemoveAtSwap(Index);
+	MoveInputs.RemoveAtSwap(Index);
+	DashDirections.RemoveAtSwap(Index);
+	DashTimes.RemoveAtSwap(Index);
+	bAttached.RemoveAtSwap(Index);
+
+	SurfacePoints.RemoveAtSwap(Index);
+	SurfaceNormals.RemoveAtSwap(Index);
+	bSurfaceHits.RemoveAtSwap(Index);
+}
+
+void FZCCrowdClimbers::Reset()
+{
+	*this = FZCCrowdClimbers();
+}
+
+void UZCClimbingCrowdSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ZCCrowdClimbing), false);
+	SetTuningFrom(UZCCharacterMovementComponent::StaticClass());
+}
+
+void UZCClimbingCrowdSubsystem::Tick(float DeltaTime)
+{
+	if (Climbers.Num() > 0)
+		UpdateClimbers(DeltaTime);
+}
+
+TStatId UZCClimbingCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UZCClimbingCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool UZCClimbingCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UZCClimbingCrowdSubsystem::SetTuningFrom(TSubclassOf<UZCCharacterMovementComponent> MovementClass)
+{
+	const UZCCharacterMovementComponent* Defaults = MovementClass ? MovementClass.GetDefaultObject() : nullptr;
+	if (!Defaults)
+		return;
+
+	Tuning.MaxClimbingSpeed = Defaults->MaxClimbingSpeed;
+	Tuning.MaxClimbingAcceleration = Defaults->MaxClimbingAcceleration;
+	Tuning.BrakingDecelerationClimbing = Defaults->BrakingDecelerationClimbing;
+	Tuning.ClimbingSnapSpeed = Defaults->ClimbingSnapSpeed;
+	Tuning.ClimbingDistanceFromSurface = Defaults->ClimbingDistanceFromSurface;
+	Tuning.ClimbDashCurve = Defaults->ClimbDashCurve;
+	Tuning.ClimbMotionProfile = Defaults->ClimbMotionProfile;
+
+	float MinTime = 0.f;
+	Tuning.ClimbDashEndTime = 0.f;
+	if (Defaults->ClimbMotionProfile)
+	{
+		Defaults->ClimbMotionProfile->ConditionalBakeTables();
+		Tuning.ClimbDashEndTime = Defaults->ClimbMotionProfile->GetDashEndTime();
+	}
+	else if (Tuning.ClimbDashCurve)
+	{
+		Tuning.ClimbDashCurve->GetTimeRange(MinTime, Tuning.ClimbDashEndTime);
+	}
+}
+
+bool FZCCrowdClimbingTuning::HasDash() const
+{
+	return ClimbMotionProfile ? ClimbMotionProfile->HasDash() : ClimbDashCurve != nullptr;
+}
+
+float FZCCrowdClimbingTuning::GetDashSpeed(float DashTime) const
+{
+	return ClimbMotionProfile ? ClimbMotionProfile->GetDashSpeed(DashTime) : ClimbDashCurve->GetFloatValue(DashTime);
+}
+
+float FZCCrowdClimbingTuning::GetSnapSpeed(float SpeedRatio) const
+{
+	if (ClimbMotionProfile && ClimbMotionProfile->HasSnapSpeed())
+		return ClimbMotionProfile->GetSnapSpeed(SpeedRatio);
+
+	return ClimbingSnapSpeed * FMath::Max(1, SpeedRatio);
+}
+
+int32 UZCClimbingCrowdSubsystem::AddClimber(const FVector& Location, const FVector& SurfaceNormal)
+{
+	return Climbers.Add(Location, SurfaceNormal.GetSafeNormal());
+}
+
+void UZCClimbingCrowdSubsystem::RemoveClimber(int32 ClimberIndex)
+{
+	if (Climbers.Positions.IsValidIndex(ClimberIndex))
+		Climbers.RemoveAtSwap(ClimberIndex);
+}
+
+void UZCClimbingCrowdSubsystem::RemoveAllClimbers()
+{
+	Climbers.Reset();
+}
+
+void UZCClimbingCrowdSubsystem::SetClimberInput(int32 ClimberIndex, const FVector2D& MoveInput)
+{
+	Climbers.MoveInputs[ClimberIndex] = MoveInput;
+}
+
+void UZCClimbingCrowdSubsystem::StartClimberDash(int32 ClimberIndex)
+{
+	if (!Tuning.HasDash() || Climbers.DashTimes[ClimberIndex] >= 0.f)
+		return;
+
+	// Same as UZCCharacterMovementComponent::CacheClimbDashDirection, dash the way we're pushing or straight up
+	const FVector& Normal = Climbers.Normals[ClimberIndex];
+	const FVector2D& Input = Climbers.MoveInputs[ClimberIndex];
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, -Normal).GetSafeNormal();
+	const FVector Up = FVector::CrossProduct(-Normal, Right);
+
+	const FVector InputDirection = FVector::CrossProduct(Normal, -Right) * Input.Y + FVector::CrossProduct(Normal, Up) * Input.X;
+	Climbers.DashDirections[ClimberIndex] = InputDirection.IsNearlyZero() ? Up : InputDirection.GetSafeNormal();
+	Climbers.DashTimes[ClimberIndex] = 0.f;
+}
+
+FTransform UZCClimbingCrowdSubsystem::GetClimberTransform(int32 ClimberIndex) const
+{
+	return FTransform(FRotationMatrix::MakeFromX(-Climbers.Normals[ClimberIndex]).ToQuat(), Climbers.Positions[ClimberIndex]);
+}
+
+void UZCClimbingCrowdSubsystem::UpdateClimbers(float DeltaTime)
+{
+	if (DeltaTime < MIN_TICK_TIME)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ZCCrowdUpdate);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("ZCClimbing::CrowdUpdate", ZCClimbingChannel);
+
+	ProbeSurfaces();
+	IntegrateClimbers(DeltaTime);
+}
+
+void UZCClimbingCrowdSubsystem::ProbeSurfaces()
+{
+	const UWorld* World = GetWorld();
+	const float ProbeLength = Tuning.ClimbingDistanceFromSurface * 2.f;
+	const ECollisionChannel ClimbChannel = UZCClimbingSettings::GetClimbTraceChannel();
+
+	// Scene queries are read only so every climber can probe at the same time
+	ParallelFor(Climbers.Num(), [&](int32 Index)
+	{
+		if (!Climbers.bAttached[Index])
+			return;
+
+		const FVector Start = Climbers.Positions[Index];
+		const FVector End = Start - Climbers.Normals[Index] * ProbeLength;
+		INC_DWORD_STAT(STAT_ZCLineTraces);
+
+		FHitResult SurfaceHit;
+		Climbers.bSurfaceHits[Index] = World->LineTraceSingleByChannel(SurfaceHit, Start, End, ClimbChannel, QueryParams);
+		Climbers.SurfacePoints[Index] = SurfaceHit.ImpactPoint;
+		Climbers.SurfaceNormals[Index] = SurfaceHit.Normal;
+	});
+}
+
+void UZCClimbingCrowdSubsystem::IntegrateClimbers(float DeltaTime)
+{
+	ParallelFor(Climbers.Num(), [&](int32 Index)
+	{
+		if (!Climbers.bAttached[Index])
+			return;
+
+		// Same exit condition as UZCCharacterMovementComponent::ShouldStopClimbing
+		const FVector Normal = Climbers.SurfaceNormals[Index];
+		if (!Climbers.bSurfaceHits[Index] || FVector::Parallel(Normal, FVector::UpVector))
+		{
+			Climbers.bAttached[Index] = 0;
+			Climbers.Velocities[Index] = FVector::ZeroVector;
+			return;
+		}
+		Climbers.Normals[Index] = Normal;
+
+		FVector& Velocity = Climbers.Velocities[Index];
+		float& DashTime = Climbers.DashTimes[Index];
+
+		if (DashTime >= 0.f)
+		{
+			DashTime += DeltaTime;
+			if (DashTime >= Tuning.ClimbDashEndTime)
+				DashTime = -1.f;
+		}
+
+		if (DashTime >= 0.f)
+		{
+			FVector& DashDirection = Climbers.DashDirections[Index];
+			DashDirection = FVector::VectorPlaneProject(DashDirection, Normal.GetSafeNormal2D());
+			Velocity = DashDirection * Tuning.GetDashSpeed(DashTime);
+		}
+		else
+		{
+			// Same surface directions AZCClimbingCharacter::Move uses when the character faces the wall
+			const FVector Right = FVector::CrossProduct(FVector::UpVector, -Normal).GetSafeNormal();
+			const FVector Up = FVector::CrossProduct(-Normal, Right);
+			const FVector2D& Input = Climbers.MoveInputs[Index];
+			const FVector InputDirection = FVector::CrossProduct(Normal, -Right) * Input.Y + FVector::CrossProduct(Normal, Up) * Input.X;
+
+			// Trimmed down CalcVelocity with no friction: accelerate with input, brake without it
+			if (!InputDirection.IsNearlyZero())
+			{
+				Velocity += InputDirection.GetClampedToMaxSize(1.f) * Tuning.MaxClimbingAcceleration * DeltaTime;
+				Velocity = Velocity.GetClampedToMaxSize(Tuning.MaxClimbingSpeed);
+			}
+			else
+			{
+				const float Speed = Velocity.Size();
+				Velocity = Speed > KINDA_SMALL_NUMBER ? Velocity * (FMath::Max(0.f, Speed - Tuning.BrakingDecelerationClimbing * DeltaTime) / Speed) : FVector::ZeroVector;
+			}
+		}
+
+		FVector& Position = Climbers.Positions[Index];
+		Position += FVector::VectorPlaneProject(Velocity, Normal) * DeltaTime;
+
+		// Same as UZCCharacterMovementComponent::SnapToClimbingSurface
+		const float DistanceToSurface = FVector::DotProduct(Climbers.SurfacePoints[Index] - Position, -Normal);
+		const FVector Offset = -Normal * (DistanceToSurface - Tuning.ClimbingDistanceFromSurface);
+		Position += Offset * Tuning.GetSnapSpeed(Velocity.Length() / Tuning.MaxClimbingSpeed) * DeltaTime;
+	});
+}
+
+static void RunCrowdClimbingBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	UZCClimbingCrowdSubsystem* Crowd = World ? World->GetSubsystem<UZCClimbingCrowdSubsystem>() : nullptr;
+	if (!Crowd)
+		return;
+
+	const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 300;
+	const int32 ClimberCounts[] = { 100, 300, 1000 };
+	constexpr float FixedDeltaTime = 1.f / 60.f;
+
+	FVector WallFace;
+	AZCClimbTerrain* Wall = AZCClimbTerrain::SpawnBenchmarkWall(World, FVector2D(40000.f, 10000.f), WallFace);
+	if (!Wall)
+		return;
+
+	FRandomStream Random(1337);
+
+	for (const int32 ClimberCount : ClimberCounts)
+	{
+		Crowd->RemoveAllClimbers();
+
+		const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(ClimberCount)));
+		for (int32 ClimberIndex = 0; ClimberIndex < ClimberCount; ++ClimberIndex)
+		{
+			const float Y = ((ClimberIndex % Columns) - Columns / 2) * 150.f;
+			const float Z = ((ClimberIndex / Columns) - Columns / 2) * 200.f;
+			const FVector Location = WallFace + FVector(-45.f, Y, Z);
+
+			Crowd->AddClimber(Location, FVector(-1.f, 0.f, 0.f));
+			Crowd->SetClimberInput(ClimberIndex, FVector2D(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f)));
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			Crowd->UpdateClimbers(FixedDeltaTime);
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogZCClimbing, Display, TEXT("Crowd climbing: %d climbers, %.3f ms/frame over %d frames"), ClimberCount, ElapsedMs / NumFrames, NumFrames);
+	}
+
+	Crowd->RemoveAllClimbers();
+	Wall->Destroy();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CrowdClimbingBenchmarkCommand(
+	TEXT("ZC.Crowd.Benchmark"),
+	TEXT("Times the crowd climbing update at 100, 300 and 1000 climbers against a generated wall.\n")
+	TEXT("Usage: ZC.Crowd.Benchmark [NumFrames=300]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunCrowdClimbingBenchmark));
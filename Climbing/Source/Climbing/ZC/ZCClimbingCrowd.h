@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ZCClimbingCrowd.generated.h"
+
+class UZCCharacterMovementComponent;
+
+/**
+ * Climbing settings shared by every crowd climber. Pulled from a UZCCharacterMovementComponent class so the crowd climbs the same way characters do.
+ */
+struct FZCCrowdClimbingTuning
+{
+	float MaxClimbingSpeed = 120.f;
+	float MaxClimbingAcceleration = 380.f;
+	float BrakingDecelerationClimbing = 550.f;
+	float ClimbingSnapSpeed = 4.f;
+	float ClimbingDistanceFromSurface = 45.f;
+	const UCurveFloat* ClimbDashCurve = nullptr;
+	const class UZCClimbMotionProfile* ClimbMotionProfile = nullptr;
+	float ClimbDashEndTime = 0.f;
+
+	// Same lookups as the movement component's. The profile's tables are safe to read from the parallel passes.
+	bool HasDash() const;
+	float GetDashSpeed(float DashTime) const;
+	float GetSnapSpeed(float SpeedRatio) const;
+};
+
+/**
+ * Crowd climbers stored as a structure of arrays so every pass over the crowd only touches the data it needs
+ */
+struct FZCCrowdClimbers
+{
+	TArray<FVector> Positions;
+	TArray<FVector> Normals;
+	TArray<FVector> Velocities;
+	TArray<FVector2D> MoveInputs;		// x is right, y is up along the surface
+	TArray<FVector> DashDirections;
+	TArray<float> DashTimes;			// negative when not dashing
+	TArray<uint8> bAttached;			// cleared once a climber loses the surface
+
+	// Written by the probe pass, read by the integrate pass
+	TArray<FVector> SurfacePoints;
+	TArray<FVector> SurfaceNormals;
+	TArray<uint8> bSurfaceHits;
+
+	int32 Num() const { return Positions.Num(); }
+	int32 Add(const FVector& Position, const FVector& Normal);
+	void RemoveAtSwap(int32 Index);
+	void Reset();
+};
+
+/**
+ * Batched climbing for large numbers of AI climbers that don't need a full character movement component each.
+ * Each climber costs one scene query per frame and all climbers are updated together in parallel.
+ */
+UCLASS()
+class CLIMBING_API UZCClimbingCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Use this movement component class's climbing settings for all crowd climbers
+	void SetTuningFrom(TSubclassOf<UZCCharacterMovementComponent> MovementClass);
+
+	int32 AddClimber(const FVector& Location, const FVector& SurfaceNormal);
+	// Moves the last climber into the removed climber's index
+	void RemoveClimber(int32 ClimberIndex);
+	void RemoveAllClimbers();
+
+	void SetClimberInput(int32 ClimberIndex, const FVector2D& MoveInput);
+	void StartClimberDash(int32 ClimberIndex);
+
+	int32 GetNumClimbers() const { return Climbers.Num(); }
+	bool IsClimberAttached(int32 ClimberIndex) const { return Climbers.bAttached[ClimberIndex] != 0; }
+	FTransform GetClimberTransform(int32 ClimberIndex) const;
+
+	// Steps the whole crowd once
+	void UpdateClimbers(float DeltaTime);
+
+private:
+	void ProbeSurfaces();
+	void IntegrateClimbers(float DeltaTime);
+
+	FZCCrowdClimbingTuning Tuning;
+	FZCCrowdClimbers Climbers;
+	FCollisionQueryParams QueryParams;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Climbing/ZC/ZCClimbContactManifold.h"
+
+// Which climbing check issued a scene query. Used to match async results back up with the check that asked for them
+enum class EZCClimbProbe : uint8
+{
+	WallSweep,
+	SurfaceAssist,
+	ClimbStartEyeHeight,
+	LedgeEyeHeight,
+	Floor,
+	LedgeWalkable,
+	LedgeClearance,
+	ContactValidation,
+};
+
+FORCEINLINE uint32 MakeClimbProbeKey(EZCClimbProbe Probe, int32 ProbeIndex)
+{
+	return (static_cast<uint32>(Probe) << 16) | static_cast<uint16>(ProbeIndex);
+}
+
+// Last completed async result for a probe plus the request currently in flight
+struct FZCAsyncClimbProbe
+{
+	FTraceHandle PendingHandle;
+	uint64 PendingFrame = 0;
+
+	TArray<FHitResult> Hits;
+	uint64 ResultFrame = 0;
+	bool bHasResult = false;
+};
+
+// Wall contacts that landed on the same face of the same component, merged so the face is only re-probed once
+struct FZCSurfaceSample
+{
+	const UPrimitiveComponent* Component = nullptr;
+	int32 FaceIndex = INDEX_NONE;
+	FIntVector QuantizedNormal = FIntVector::ZeroValue;
+
+	// Mean impact point of the merged hits
+	FVector ImpactPoint = FVector::ZeroVector;
+	// Number of wall hits merged into this sample
+	int32 Weight = 0;
+
+	bool IsSameFace(const FZCClimbContact& Contact, const FIntVector& HitNormal) const
+	{
+		return Component == Contact.GetComponent() && FaceIndex == Contact.FaceIndex && QuantizedNormal == HitNormal;
+	}
+};
+
+// A single hit query already answered this tick. Later queries along the same ray with the same shape reuse it, whatever their length.
+struct FZCCachedClimbQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector Direction = FVector::ZeroVector;
+	float Length = 0.f;
+	ECollisionShape::Type ShapeType = ECollisionShape::Line;
+	FVector ShapeExtent = FVector::ZeroVector;
+	ECollisionChannel Channel = ECC_WorldStatic;
+	FHitResult Hit;
+
+	bool IsSameRay(const FVector& InStart, const FVector& InDirection, const FCollisionShape& Shape, ECollisionChannel InChannel) const
+	{
+		return Channel == InChannel && ShapeType == Shape.ShapeType && ShapeExtent.Equals(Shape.GetExtent()) && Start.Equals(InStart) && Direction.Equals(InDirection);
+	}
+
+	// A shorter query sees the same first hit or nothing, and a longer one stops at the same hit if there was one
+	bool CanAnswer(float QueryLength) const
+	{
+		return QueryLength <= Length || Hit.bBlockingHit;
+	}
+};
+
+struct FZCClimbQueryCounters
+{
+	// Async requests handed to the physics scene
+	int32 Issued = 0;
+	// Async results that were fresh enough to be used
+	int32 Consumed = 0;
+	// Times there was no fresh async result and a blocking query ran instead
+	int32 SyncFallbacks = 0;
+
+	// Single hit queries answered from the per tick cache, and ones that had to go to the physics scene
+	int32 CacheHits = 0;
+	int32 CacheMisses = 0;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "Climbing/ZC/ZCTypes.h"
+#include "ZCClimbingSettings.generated.h"
+
+/**
+ * Project wide climbing settings, under Project Settings > Game > Climbing. Anything the climbing movement, the offline bakes,
+ * the crowd and the climb proxies have to agree on lives here rather than on each of them.
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Climbing"))
+class CLIMBING_API UZCClimbingSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Channel every climbing probe, bake and proxy traces against. The ledge clearance check is the one exception, it uses the capsule's own channel.
+	UPROPERTY(config, EditAnywhere, Category = "Queries")
+	TEnumAsByte<ECollisionChannel> ClimbTraceChannel = ECC_ZCClimbable;
+
+	static ECollisionChannel GetClimbTraceChannel() { return GetDefault<UZCClimbingSettings>()->ClimbTraceChannel; }
+};
@@ -0,0 +1,81 @@
+#include "Climbing/ZC/ZCClimbingStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(ZCClimbingChannel);
+
+DEFINE_STAT(STAT_ZCClimbStage_WallSweep);
+DEFINE_STAT(STAT_ZCClimbStage_PhysClimbing);
+DEFINE_STAT(STAT_ZCClimbStage_SurfaceInfo);
+DEFINE_STAT(STAT_ZCClimbStage_Velocity);
+DEFINE_STAT(STAT_ZCClimbStage_MoveAlongSurface);
+DEFINE_STAT(STAT_ZCClimbStage_FloorCheck);
+DEFINE_STAT(STAT_ZCClimbStage_LedgeClimb);
+DEFINE_STAT(STAT_ZCClimbStage_SnapToSurface);
+DEFINE_STAT(STAT_ZCCrowdUpdate);
+DEFINE_STAT(STAT_ZCBatchQueries);
+DEFINE_STAT(STAT_ZCClimbLinkLookup);
+DEFINE_STAT(STAT_ZCClimbStartClaimCheck);
+DEFINE_STAT(STAT_ZCClimbStartFullCheck);
+
+DEFINE_STAT(STAT_ZCSweeps);
+DEFINE_STAT(STAT_ZCLineTraces);
+DEFINE_STAT(STAT_ZCOverlaps);
+DEFINE_STAT(STAT_ZCHitsReturned);
+DEFINE_STAT(STAT_ZCAsyncResultsUsed);
+DEFINE_STAT(STAT_ZCQueryCacheHits);
+DEFINE_STAT(STAT_ZCQueryCacheMisses);
+DEFINE_STAT(STAT_ZCActiveClimbers);
+
+DEFINE_STAT(STAT_ZCWallSweepsRun);
+DEFINE_STAT(STAT_ZCWallSweepsSkipped);
+DEFINE_STAT(STAT_ZCProximityOverlaps);
+
+DEFINE_STAT(STAT_ZCContactsTracked);
+DEFINE_STAT(STAT_ZCContactReprobes);
+DEFINE_STAT(STAT_ZCContactsDropped);
+
+DEFINE_STAT(STAT_ZCSurfaceAssistProbes);
+DEFINE_STAT(STAT_ZCSurfaceProbesSaved);
+
+DEFINE_STAT(STAT_ZCClimbingCorrections);
+DEFINE_STAT(STAT_ZCClimbStartsCached);
+DEFINE_STAT(STAT_ZCClimbStartsRayConfirmed);
+DEFINE_STAT(STAT_ZCClimbStartReprobes);
+DEFINE_STAT(STAT_ZCClimbStartClaimsBlocked);
+DEFINE_STAT(STAT_ZCClimbStartsRejected);
+DEFINE_STAT(STAT_ZCProxiesFollowingState);
+
+DEFINE_STAT(STAT_ZCClimbBudgetOverruns);
+
+void FZCClimbingProfile::Accumulate(const FZCClimbingProfile& Other)
+{
+	for (int32 Stage = 0; Stage < static_cast<int32>(EZCClimbStage::Num); ++Stage)
+		StageCycles[Stage] += Other.StageCycles[Stage];
+
+	Sweeps += Other.Sweeps;
+	LineTraces += Other.LineTraces;
+	Overlaps += Other.Overlaps;
+	HitsReturned += Other.HitsReturned;
+	QueryCacheHits += Other.QueryCacheHits;
+	QueryCacheMisses += Other.QueryCacheMisses;
+
+	ClimbTicks += Other.ClimbTicks;
+	PeakTickQueries = FMath::Max(PeakTickQueries, Other.PeakTickQueries);
+	PeakTickCycles = FMath::Max(PeakTickCycles, Other.PeakTickCycles);
+	BudgetOverruns += Other.BudgetOverruns;
+}
+
+const TCHAR* GetClimbStageName(EZCClimbStage Stage)
+{
+	switch (Stage)
+	{
+	case EZCClimbStage::WallSweep:			return TEXT("WallSweep");
+	case EZCClimbStage::PhysClimbing:		return TEXT("PhysClimbing");
+	case EZCClimbStage::SurfaceInfo:		return TEXT("SurfaceInfo");
+	case EZCClimbStage::Velocity:			return TEXT("Velocity");
+	case EZCClimbStage::MoveAlongSurface:	return TEXT("MoveAlongSurface");
+	case EZCClimbStage::FloorCheck:			return TEXT("FloorCheck");
+	case EZCClimbStage::LedgeClimb:			return TEXT("LedgeClimb");
+	case EZCClimbStage::SnapToSurface:		return TEXT("SnapToSurface");
+	default:								return TEXT("Unknown");
+	}
+}
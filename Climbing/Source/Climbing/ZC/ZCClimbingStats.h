@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("ZCClimbing"), STATGROUP_ZCClimbing, STATCAT_Advanced);
+
+// Trace channel for the climbing stage scopes, so Insights captures can include them on their own with -trace=ZCClimbing.
+// Available in every build with trace compiled in, which includes Test builds.
+UE_TRACE_CHANNEL_EXTERN(ZCClimbingChannel, CLIMBING_API);
+
+// Climbing stages
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wall Sweep"), STAT_ZCClimbStage_WallSweep, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysClimbing"), STAT_ZCClimbStage_PhysClimbing, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Info"), STAT_ZCClimbStage_SurfaceInfo, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Velocity"), STAT_ZCClimbStage_Velocity, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Move Along Surface"), STAT_ZCClimbStage_MoveAlongSurface, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Floor Check"), STAT_ZCClimbStage_FloorCheck, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ledge Climb"), STAT_ZCClimbStage_LedgeClimb, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snap To Surface"), STAT_ZCClimbStage_SnapToSurface, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crowd Update"), STAT_ZCCrowdUpdate, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Queries"), STAT_ZCBatchQueries, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Link Lookup"), STAT_ZCClimbLinkLookup, STATGROUP_ZCClimbing, CLIMBING_API);
+// What the server spends on a client's climb start, for comparing the claim checks against the full checks they stand in for
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Start Claim Check"), STAT_ZCClimbStartClaimCheck, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Start Full Check"), STAT_ZCClimbStartFullCheck, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Scene queries
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sweeps"), STAT_ZCSweeps, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Line Traces"), STAT_ZCLineTraces, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overlaps"), STAT_ZCOverlaps, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits Returned"), STAT_ZCHitsReturned, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Async Results Used"), STAT_ZCAsyncResultsUsed, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Cache Hits"), STAT_ZCQueryCacheHits, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Cache Misses"), STAT_ZCQueryCacheMisses, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Climbers"), STAT_ZCActiveClimbers, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Proximity gating
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wall Sweeps Run"), STAT_ZCWallSweepsRun, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wall Sweeps Skipped"), STAT_ZCWallSweepsSkipped, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proximity Overlaps"), STAT_ZCProximityOverlaps, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Contact tracking
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wall Sweeps Tracked"), STAT_ZCContactsTracked, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Contact Reprobes"), STAT_ZCContactReprobes, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wall Contacts Dropped"), STAT_ZCContactsDropped, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Surface sampling
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Assist Probes"), STAT_ZCSurfaceAssistProbes, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Probes Saved"), STAT_ZCSurfaceProbesSaved, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Networking
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climbing Corrections"), STAT_ZCClimbingCorrections, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Starts Confirmed From Cache"), STAT_ZCClimbStartsCached, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Starts Confirmed By Ray"), STAT_ZCClimbStartsRayConfirmed, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Start Reprobes"), STAT_ZCClimbStartReprobes, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Start Claims Blocked From View"), STAT_ZCClimbStartClaimsBlocked, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Starts Rejected"), STAT_ZCClimbStartsRejected, STATGROUP_ZCClimbing, CLIMBING_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proxies Following Replicated State"), STAT_ZCProxiesFollowingState, STATGROUP_ZCClimbing, CLIMBING_API);
+
+// Budgets
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Tick Budget Overruns"), STAT_ZCClimbBudgetOverruns, STATGROUP_ZCClimbing, CLIMBING_API);
+
+enum class EZCClimbStage : uint8
+{
+	WallSweep,
+	PhysClimbing,
+	SurfaceInfo,
+	Velocity,
+	MoveAlongSurface,
+	FloorCheck,
+	LedgeClimb,
+	SnapToSurface,
+	Num
+};
+
+const TCHAR* GetClimbStageName(EZCClimbStage Stage);
+
+/**
+ * Per character timings and scene query counts, accumulated until reset. Cheap enough to leave on in every build.
+ */
+struct FZCClimbingProfile
+{
+	uint64 StageCycles[static_cast<int32>(EZCClimbStage::Num)] = {};
+	int32 Sweeps = 0;
+	int32 LineTraces = 0;
+	int32 Overlaps = 0;
+	int32 HitsReturned = 0;
+	int32 QueryCacheHits = 0;
+	int32 QueryCacheMisses = 0;
+
+	// Ticks spent climbing, the most expensive of them, and how many went over the ZC.Budget limits
+	int32 ClimbTicks = 0;
+	int32 PeakTickQueries = 0;
+	uint64 PeakTickCycles = 0;
+	int32 BudgetOverruns = 0;
+
+	double GetStageMilliseconds(EZCClimbStage Stage) const { return FPlatformTime::ToMilliseconds64(StageCycles[static_cast<int32>(Stage)]); }
+	double GetPeakTickMicroseconds() const { return FPlatformTime::ToMilliseconds64(PeakTickCycles) * 1000.0; }
+	int32 GetNumQueries() const { return Sweeps + LineTraces + Overlaps; }
+	float GetQueryCacheHitRate() const { return QueryCacheHits + QueryCacheMisses > 0 ? static_cast<float>(QueryCacheHits) / (QueryCacheHits + QueryCacheMisses) : 0.f; }
+	void Accumulate(const FZCClimbingProfile& Other);
+	void Reset() { *this = FZCClimbingProfile(); }
+};
+
+struct FZCClimbStageScope
+{
+	FZCClimbStageScope(FZCClimbingProfile& InProfile, EZCClimbStage InStage)
+		: Profile(InProfile), Stage(InStage), StartCycles(FPlatformTime::Cycles64()) {}
+
+	~FZCClimbStageScope()
+	{
+		Profile.StageCycles[static_cast<int32>(Stage)] += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+	FZCClimbingProfile& Profile;
+	EZCClimbStage Stage;
+	uint64 StartCycles;
+};
+
+// Times the rest of the enclosing scope into the movement component's ClimbingProfile, the ZCClimbing stat group and the ZCClimbing trace channel
+#define ZC_CLIMB_STAGE_SCOPE(Stage) \
+	SCOPE_CYCLE_COUNTER(STAT_ZCClimbStage_##Stage); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("ZCClimbing::" #Stage, ZCClimbingChannel); \
+	FZCClimbStageScope ANONYMOUS_VARIABLE(ClimbStageScope)(ClimbingProfile, EZCClimbStage::Stage)
@@ -0,0 +1,485 @@
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCCharacterMovementComponent.h"
+#include "Climbing/ZC/ZCClimbingStats.h"
+#include "Climbing/ZC/ZCClimbTerrain.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/WorldSettings.h"
+#include "InputActionValue.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The shipping character, for its tuning and because ledge climbs only finish once its montage does
+static const TCHAR* ClimbingTestCharacterClass = TEXT("/Game/ZC/Blueprints/BP_ZCCharacter.BP_ZCCharacter_C");
+
+static constexpr float ClimbingTestDeltaTime = 1.f / 60.f;
+
+/**
+ * A headless game world with one climbing character in it, ticked at a fixed step the same way UZCClimbBenchmarkCommandlet does.
+ * Tracks what every climbing tick cost while it runs.
+ */
+class FZCClimbingTestWorld
+{
+public:
+	struct FTickCosts
+	{
+		int32 ClimbTicks = 0;
+		int32 PeakTickQueries = 0;
+		int64 TotalQueries = 0;
+		uint64 TotalCycles = 0;
+
+		double GetAverageTickQueries() const { return ClimbTicks > 0 ? static_cast<double>(TotalQueries) / ClimbTicks : 0.0; }
+		double GetAverageTickMicroseconds() const { return ClimbTicks > 0 ? FPlatformTime::ToMilliseconds64(TotalCycles) * 1000.0 / ClimbTicks : 0.0; }
+	};
+
+	~FZCClimbingTestWorld()
+	{
+		if (!World)
+			return;
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	AZCClimbTerrain* CreateWorld(FAutomationTestBase& Test)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ZCClimbingTest"));
+		if (!World)
+		{
+			Test.AddError(TEXT("Couldn't create a world"));
+			return nullptr;
+		}
+
+		World->AddToRoot();
+		GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+
+		// Just the ground, the test adds its own shapes
+		FZCClimbTerrainSettings Settings;
+		Settings.FieldSize = 4000.f;
+		Settings.NumWalls = 0;
+		Settings.NumOverhangs = 0;
+		Settings.NumLedges = 0;
+		Settings.NumStairs = 0;
+		Settings.NumLandscapePatches = 0;
+		return AZCClimbTerrain::SpawnClimbTerrain(World, Settings);
+	}
+
+	bool SpawnCharacter(FAutomationTestBase& Test, const FTransform& Start)
+	{
+		UClass* CharacterClass = LoadClass<AZCClimbingCharacter>(nullptr, ClimbingTestCharacterClass);
+		if (!CharacterClass)
+		{
+			Test.AddError(FString::Printf(TEXT("Couldn't load %s"), ClimbingTestCharacterClass));
+			return false;
+		}
+
+		World->BeginPlay();
+		if (!World->HasBegunPlay())
+			World->GetWorldSettings()->NotifyBeginPlay();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Character = World->SpawnActor<AZCClimbingCharacter>(CharacterClass, Start, SpawnParams);
+		Movement = Character ? Character->GetZCMovementComponent() : nullptr;
+		if (!Movement)
+		{
+			Test.AddError(TEXT("Couldn't spawn a climbing character"));
+			return false;
+		}
+
+		Character->SpawnDefaultController();
+		if (Character->GetController())
+			Character->GetController()->SetControlRotation(Start.Rotator());
+
+		// Let it land before driving it
+		Tick();
+		Tick();
+		return true;
+	}
+
+	void Tick()
+	{
+		Movement->ResetClimbingProfile();
+
+		// Query caches and async results are keyed on the frame counter
+		++GFrameCounter;
+		World->Tick(LEVELTICK_All, ClimbingTestDeltaTime);
+
+		bSawLedgeClimb |= Movement->IsLedgeClimbing();
+
+		// The profile was reset above, so its peaks are this tick's figures
+		const FZCClimbingProfile& Profile = Movement->GetClimbingProfile();
+		if (Profile.ClimbTicks == 0)
+			return;
+
+		++Costs.ClimbTicks;
+		Costs.PeakTickQueries = FMath::Max(Costs.PeakTickQueries, Profile.PeakTickQueries);
+		Costs.TotalQueries += Profile.PeakTickQueries;
+		Costs.TotalCycles += Profile.PeakTickCycles;
+	}
+
+	// Feeds Input every tick until Done returns true or Seconds run out. Returns whether Done did.
+	bool TickUntil(float Seconds, TFunctionRef<void(int32 Frame)> Input, TFunctionRef<bool()> Done)
+	{
+		const int32 NumFrames = FMath::CeilToInt(Seconds / ClimbingTestDeltaTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			if (Done())
+				return true;
+
+			Input(Frame);
+			Tick();
+		}
+
+		return Done();
+	}
+
+	bool GrabWall()
+	{
+		return TickUntil(3.f, [this](int32 Frame)
+		{
+			Character->Move(FInputActionValue(FVector2D(0.f, 1.f)));
+			if (Frame % 10 == 0)
+				Character->Climb(FInputActionValue(true));
+		}, [this]() { return Movement->IsClimbing(); });
+	}
+
+	bool MoveUntil(float Seconds, const FVector2D& Direction, TFunctionRef<bool()> Done)
+	{
+		return TickUntil(Seconds, [this, Direction](int32) { Character->Move(FInputActionValue(Direction)); }, Done);
+	}
+
+	void ClimbFor(float Seconds, const FVector2D& Direction)
+	{
+		MoveUntil(Seconds, Direction, []() { return false; });
+	}
+
+	bool IsWalking() const { return Movement->MovementMode == MOVE_Walking; }
+
+	// Hands the movement component a client's move asking to start climbing, without a claimed contact, and returns whether the
+	// server let it. The world is standalone so the character has authority, and outside a move RPC there is no move data to claim with.
+	bool ReceiveClaimlessClimbStart()
+	{
+		Movement->UpdateFromCompressedFlags(0);
+		Movement->UpdateFromCompressedFlags(FSavedMove_ZCCharacter::FLAG_WantsToClimb);
+		return Movement->bWantsToClimb;
+	}
+
+	// Not every allocator counts its calls
+	static bool DoesAllocatorCountCalls()
+	{
+		const uint64 CallsBefore = FMalloc::TotalMallocCalls;
+		void* Probe = FMemory::Malloc(16);
+		FMemory::Free(Probe);
+		return FMalloc::TotalMallocCalls != CallsBefore;
+	}
+
+	// Ticks just the movement component with Input held, so nothing else in the world allocates in between. Returns the
+	// mallocs and reallocs made while it ticked.
+	uint64 TickMovementFor(float Seconds, const FVector2D& Input)
+	{
+		uint64 Allocations = 0;
+		const int32 NumFrames = FMath::CeilToInt(Seconds / ClimbingTestDeltaTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Character->Move(FInputActionValue(Input));
+			++GFrameCounter;
+
+			const uint64 CallsBefore = FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+			Movement->TickComponent(ClimbingTestDeltaTime, LEVELTICK_All, &Movement->PrimaryComponentTick);
+			Allocations += FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls - CallsBefore;
+		}
+
+		return Allocations;
+	}
+
+	UWorld* World = nullptr;
+	AZCClimbingCharacter* Character = nullptr;
+	UZCCharacterMovementComponent* Movement = nullptr;
+	FTickCosts Costs;
+	bool bSawLedgeClimb = false;
+};
+
+namespace ZCClimbingTests
+{
+	// Every shape is climbed from -X, with its face starting at the origin and its walkable top at Height
+	struct FGeometryCase
+	{
+		const TCHAR* Name;
+		// Face angle from the ground, past 90 leans out over the climber
+		float FaceAngle = 90.f;
+		float Height = 400.f;
+		// How deep the walkable top is
+		float TopDepth = 400.f;
+		float Width = 800.f;
+		// Perpendicular walls either side, a corner is where the climber moves along into
+		bool bInsideCorners = false;
+		// Steps up to the face, so climbing down ends on a different floor height than climbing started from
+		bool bSteppedFloor = false;
+		// Uneven ground from the terrain generator's landscape patches in front of the face, so climbing down lands on a tilted cell
+		bool bLandscapeFloor = false;
+
+		// Per climbing tick. Generous on purpose, the test logs what it measured so they can be tightened.
+		int32 MaxTickQueries = 16;
+		double MaxAverageTickMicroseconds = 300.0;
+	};
+
+	static const FGeometryCase GeometryCases[] =
+	{
+		{ TEXT("Wall"), 90.f },
+		// 45 and 135 are the limits of MinVerticalDegreesToStartClimbing either side of vertical
+		{ TEXT("Slab45"), 45.f },
+		{ TEXT("Slab60"), 60.f },
+		{ TEXT("Slab75"), 75.f },
+		{ TEXT("Overhang100"), 100.f },
+		{ TEXT("Overhang110"), 110.f },
+		{ TEXT("Overhang135"), 135.f },
+		{ TEXT("ThinLedge"), 90.f, 400.f, 100.f },
+		// The sides of a narrow block, moving along goes round them
+		{ TEXT("OutsideCorner"), 90.f, 400.f, 400.f, 200.f, false, false, false, 24 },
+		{ TEXT("InsideCorner"), 90.f, 400.f, 400.f, 800.f, true, false, false, 24 },
+		{ TEXT("SteppedFloor"), 90.f, 400.f, 400.f, 800.f, false, true },
+		{ TEXT("Landscape"), 90.f, 400.f, 400.f, 800.f, false, false, true },
+	};
+
+	static const FGeometryCase* FindGeometryCase(const FString& Name)
+	{
+		for (const FGeometryCase& Case : GeometryCases)
+		{
+			if (Name == Case.Name)
+				return &Case;
+		}
+
+		return nullptr;
+	}
+
+	// Returns where the climber should start, looking at the face
+	static FTransform BuildGeometry(AZCClimbTerrain& Terrain, const FGeometryCase& Case)
+	{
+		static constexpr float Thickness = 50.f;
+
+		if (FMath::IsNearlyEqual(Case.FaceAngle, 90.f))
+		{
+			// A solid block, so the top and the sides are climbable too
+			Terrain.AddBox(FVector(Case.TopDepth * 0.5f, 0.f, Case.Height * 0.5f), FRotator::ZeroRotator, FVector(Case.TopDepth, Case.Width, Case.Height));
+		}
+		else
+		{
+			// A plate leaning along Up from the origin, with a roof slab to stand on once over its top edge
+			const float Pitch = Case.FaceAngle - 90.f;
+			const FRotator Rotation(Pitch, 0.f, 0.f);
+			const FVector Up = Rotation.RotateVector(FVector::UpVector);
+			const FVector Inward = Rotation.RotateVector(FVector::ForwardVector);
+			const float Length = Case.Height / Up.Z;
+
+			Terrain.AddBox(Up * Length * 0.5f + Inward * Thickness * 0.5f, Rotation, FVector(Thickness, Case.Width, Length));
+
+			const FVector TopEdge = Up * Length;
+			Terrain.AddBox(FVector(TopEdge.X + Case.TopDepth * 0.5f, 0.f, Case.Height - Thickness * 0.5f), FRotator::ZeroRotator, FVector(Case.TopDepth, Case.Width, Thickness));
+		}
+
+		if (Case.bInsideCorners)
+		{
+			for (const float Side : { -1.f, 1.f })
+				Terrain.AddBox(FVector(-200.f, Side * 350.f, Case.Height * 0.5f), FRotator::ZeroRotator, FVector(400.f, 400.f, Case.Height));
+		}
+
+		float StartX = -300.f;
+		float StartZ = 100.f;
+		if (Case.bSteppedFloor)
+		{
+			static constexpr int32 NumSteps = 3;
+			static constexpr float Rise = 20.f;
+			static constexpr float Run = 100.f;
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				const float StepHeight = Rise * (NumSteps - Step);
+				Terrain.AddBox(FVector(-Run * (Step + 0.5f), 0.f, StepHeight * 0.5f), FRotator::ZeroRotator, FVector(Run, Case.Width, StepHeight));
+			}
+
+			StartX = -Run * NumSteps - 150.f;
+		}
+
+		if (Case.bLandscapeFloor)
+		{
+			// Low enough to walk over, and always the same bumps
+			static constexpr int32 Resolution = 8;
+			static constexpr float CellSize = 100.f;
+			static constexpr float LandscapeHeight = 60.f;
+			Terrain.AddLandscapePatch(FVector(-Resolution * CellSize, -Case.Width * 0.5f, 0.f), Resolution, CellSize, LandscapeHeight, FVector2D(17.f, 5.f));
+			StartZ += LandscapeHeight;
+		}
+
+		// Overhangs lean out over where a standing capsule would be, start far enough back to walk up to them
+		if (Case.FaceAngle > 90.f)
+			StartX -= FMath::Tan(FMath::DegreesToRadians(Case.FaceAngle - 90.f)) * 200.f;
+
+		Terrain.CommitBoxes();
+		return FTransform(FRotator::ZeroRotator, FVector(StartX, 0.f, StartZ));
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FZCClimbingGeometryTest, "ZC.Climbing.Geometry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+void FZCClimbingGeometryTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const ZCClimbingTests::FGeometryCase& Case : ZCClimbingTests::GeometryCases)
+	{
+		OutBeautifiedNames.Add(Case.Name);
+		OutTestCommands.Add(Case.Name);
+	}
+}
+
+bool FZCClimbingGeometryTest::RunTest(const FString& Parameters)
+{
+	const ZCClimbingTests::FGeometryCase* Case = ZCClimbingTests::FindGeometryCase(Parameters);
+	if (!Case)
+	{
+		AddError(FString::Printf(TEXT("No geometry case called %s"), *Parameters));
+		return false;
+	}
+
+	FZCClimbingTestWorld TestWorld;
+	AZCClimbTerrain* Terrain = TestWorld.CreateWorld(*this);
+	if (!Terrain)
+		return false;
+
+	const FTransform Start = ZCClimbingTests::BuildGeometry(*Terrain, *Case);
+	if (!TestWorld.SpawnCharacter(*this, Start))
+		return false;
+
+	const UZCCharacterMovementComponent* Movement = TestWorld.Movement;
+	const AZCClimbingCharacter* Character = TestWorld.Character;
+
+	// Up
+	if (!TestTrue(TEXT("Grabbed the face"), TestWorld.GrabWall()))
+		return false;
+
+	const float GrabHeight = Character->GetActorLocation().Z;
+	TestWorld.ClimbFor(1.f, FVector2D(0.f, 1.f));
+	TestTrue(TEXT("Still climbing after climbing up"), Movement->IsClimbing());
+	TestTrue(TEXT("Climbed up"), Character->GetActorLocation().Z > GrabHeight + 50.f);
+
+	// Along, both ways
+	TestWorld.ClimbFor(1.5f, FVector2D(1.f, 0.f));
+	TestTrue(TEXT("Still climbing after climbing right"), Movement->IsClimbing());
+	TestWorld.ClimbFor(1.5f, FVector2D(-1.f, 0.f));
+	TestTrue(TEXT("Still climbing after climbing left"), Movement->IsClimbing());
+
+	// Down until the floor takes over
+	const bool bClimbedDown = TestWorld.MoveUntil(8.f, FVector2D(0.f, -1.f), [&TestWorld]() { return TestWorld.IsWalking(); });
+	TestTrue(TEXT("Walking after climbing down"), bClimbedDown);
+
+	// Over the top
+	if (!TestTrue(TEXT("Grabbed the face again"), TestWorld.GrabWall()))
+		return false;
+
+	const bool bClimbedOver = TestWorld.MoveUntil(20.f, FVector2D(0.f, 1.f), [&TestWorld]() { return TestWorld.bSawLedgeClimb && TestWorld.IsWalking(); });
+	TestTrue(TEXT("Climbed over the ledge"), TestWorld.bSawLedgeClimb);
+	TestTrue(TEXT("Walking after the ledge climb"), bClimbedOver);
+	TestTrue(TEXT("Standing on top"), Character->GetActorLocation().Z > Case->Height);
+
+	const FZCClimbingTestWorld::FTickCosts& Costs = TestWorld.Costs;
+	AddInfo(FString::Printf(TEXT("%s: %d climbing ticks, peak %d queries, avg %.1f queries, avg %.1f us per tick"), Case->Name,
+		Costs.ClimbTicks, Costs.PeakTickQueries, Costs.GetAverageTickQueries(), Costs.GetAverageTickMicroseconds()));
+
+	TestTrue(FString::Printf(TEXT("Peak queries per climbing tick %d within %d"), Costs.PeakTickQueries, Case->MaxTickQueries), Costs.PeakTickQueries <= Case->MaxTickQueries);
+	TestTrue(FString::Printf(TEXT("Average time per climbing tick %.1f us within %.1f us"), Costs.GetAverageTickMicroseconds(), Case->MaxAverageTickMicroseconds),
+		Costs.GetAverageTickMicroseconds() <= Case->MaxAverageTickMicroseconds);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZCClimbingClaimlessStartTest, "ZC.Climbing.ClaimlessClimbStart", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FZCClimbingClaimlessStartTest::RunTest(const FString& Parameters)
+{
+	// Walks into a box facing it, then sends the server a climb start with nothing to back it up
+	const auto ReceiveClimbStartAgainst = [this](float BoxHeight, bool& bOutAccepted)
+	{
+		FZCClimbingTestWorld TestWorld;
+		AZCClimbTerrain* Terrain = TestWorld.CreateWorld(*this);
+		if (!Terrain)
+			return false;
+
+		Terrain->AddBox(FVector(200.f, 0.f, BoxHeight * 0.5f), FRotator::ZeroRotator, FVector(400.f, 800.f, BoxHeight));
+		Terrain->CommitBoxes();
+		if (!TestWorld.SpawnCharacter(*this, FTransform(FVector(-300.f, 0.f, 100.f))))
+			return false;
+
+		TestWorld.MoveUntil(3.f, FVector2D(0.f, 1.f), []() { return false; });
+		TestWorld.MoveUntil(0.25f, FVector2D::ZeroVector, []() { return false; });
+		if (!TestTrue(FString::Printf(TEXT("Walking up against the %.0f cm box"), BoxHeight), TestWorld.IsWalking() && TestWorld.Character->GetActorLocation().X > -100.f))
+			return false;
+
+		bOutAccepted = TestWorld.ReceiveClaimlessClimbStart();
+		return true;
+	};
+
+	// Too high to step onto, too low to reach eye height. Facing it is all the client could show for it.
+	bool bAcceptedKneeHigh = true;
+	if (ReceiveClimbStartAgainst(50.f, bAcceptedKneeHigh))
+		TestFalse(TEXT("Claimless climb start against a knee high box rejected"), bAcceptedKneeHigh);
+
+	bool bAcceptedWall = false;
+	if (ReceiveClimbStartAgainst(1000.f, bAcceptedWall))
+		TestTrue(TEXT("Claimless climb start against a wall accepted"), bAcceptedWall);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZCClimbingAllocationTest, "ZC.Climbing.SteadyStateAllocations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FZCClimbingAllocationTest::RunTest(const FString& Parameters)
+{
+	FZCClimbingTestWorld TestWorld;
+	AZCClimbTerrain* Terrain = TestWorld.CreateWorld(*this);
+	if (!Terrain)
+		return false;
+
+	// Tall and wide enough that a few seconds of climbing any way never reaches an edge
+	Terrain->AddBox(FVector(200.f, 0.f, 500.f), FRotator::ZeroRotator, FVector(400.f, 2000.f, 1000.f));
+	Terrain->CommitBoxes();
+	if (!TestWorld.SpawnCharacter(*this, FTransform(FVector(-300.f, 0.f, 100.f))))
+		return false;
+
+	if (!TestTrue(TEXT("Grabbed the wall"), TestWorld.GrabWall()))
+		return false;
+
+	// Lets the query caches, contact tracker and stat arrays grow to their working sizes
+	TestWorld.ClimbFor(1.f, FVector2D(0.f, 1.f));
+
+	if (!FZCClimbingTestWorld::DoesAllocatorCountCalls())
+	{
+		AddWarning(TEXT("The allocator doesn't count its calls, run with -ansimalloc to check climbing allocations"));
+		return true;
+	}
+
+	static const TPair<const TCHAR*, FVector2D> Inputs[] =
+	{
+		{ TEXT("holding still"), FVector2D::ZeroVector },
+		{ TEXT("climbing up"), FVector2D(0.f, 1.f) },
+		{ TEXT("climbing right"), FVector2D(1.f, 0.f) },
+		{ TEXT("climbing left"), FVector2D(-1.f, 0.f) },
+	};
+
+	for (const TPair<const TCHAR*, FVector2D>& Input : Inputs)
+	{
+		// A change of direction can reach parts of the surface the caches haven't seen yet
+		TestWorld.TickMovementFor(0.25f, Input.Value);
+
+		const uint64 Allocations = TestWorld.TickMovementFor(1.f, Input.Value);
+		TestEqual(FString::Printf(TEXT("Allocations in a second of %s"), Input.Key), Allocations, static_cast<uint64>(0));
+		TestTrue(FString::Printf(TEXT("Still climbing after %s"), Input.Key), TestWorld.Movement->IsClimbing());
+	}
+
+	return true;
+}
+
+#endif
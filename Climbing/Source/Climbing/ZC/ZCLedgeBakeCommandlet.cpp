@@ -0,0 +1,103 @@
+#include "Climbing/ZC/ZCLedgeBakeCommandlet.h"
+#include "Climbing/ZC/ZCLedgeGraph.h"
+#include "Climbing/Climbing.h"
+
+#include "Engine/World.h"
+#include "Engine/LevelBounds.h"
+#include "EngineUtils.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UZCLedgeBakeCommandlet::UZCLedgeBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UZCLedgeBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapsParam;
+	if (!FParse::Value(*Params, TEXT("Maps="), MapsParam, false))
+	{
+		UE_LOG(LogZCClimbing, Error, TEXT("Usage: -run=ZCLedgeBake -Maps=/Game/Maps/MapA+/Game/Maps/MapB"));
+		return 1;
+	}
+
+	TArray<FString> MapNames;
+	MapsParam.ParseIntoArray(MapNames, TEXT("+"));
+
+	int32 NumFailed = 0;
+	for (const FString& MapName : MapNames)
+		if (!BakeMap(MapName))
+			++NumFailed;
+
+	return NumFailed > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
+
+bool UZCLedgeBakeCommandlet::BakeMap(const FString& MapName)
+{
+#if WITH_EDITOR
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogZCClimbing, Error, TEXT("Couldn't load map %s"), *MapName);
+		return false;
+	}
+
+	// Collision has to be set up for the bake's scene queries
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValues;
+		InitValues.RequiresHitProxies(false).ShouldSimulatePhysics(false).EnableTraceCollision(true).CreateNavigation(false).CreateAISystem(false).AllowAudioPlayback(false).CreatePhysicsScene(true);
+		World->InitWorld(InitValues);
+	}
+	World->UpdateWorldComponents(true, false);
+
+	TArray<AZCLedgeGraph*> LedgeGraphs;
+	for (TActorIterator<AZCLedgeGraph> It(World); It; ++It)
+		LedgeGraphs.Add(*It);
+
+	if (LedgeGraphs.IsEmpty())
+	{
+		AZCLedgeGraph* LedgeGraph = World->SpawnActor<AZCLedgeGraph>();
+		LedgeGraph->SetBakeBounds(ALevelBounds::CalculateLevelBounds(World->PersistentLevel));
+		LedgeGraphs.Add(LedgeGraph);
+	}
+
+	int32 NumLedges = 0;
+	int32 NumLedgePoints = 0;
+	for (AZCLedgeGraph* LedgeGraph : LedgeGraphs)
+	{
+		LedgeGraph->Bake();
+		NumLedges += LedgeGraph->GetNumLedges();
+		NumLedgePoints += LedgeGraph->GetNumLedgePoints();
+	}
+
+	UE_LOG(LogZCClimbing, Display, TEXT("%s: baked %d ledges with %d points"), *MapName, NumLedges, NumLedgePoints);
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetMapPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	const bool bSaved = UPackage::SavePackage(Package, World, *Filename, SaveArgs);
+	if (!bSaved)
+		UE_LOG(LogZCClimbing, Error, TEXT("Couldn't save %s"), *Filename);
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bSaved;
+#else
+	return false;
+#endif
+}
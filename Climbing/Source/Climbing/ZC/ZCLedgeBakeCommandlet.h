@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ZCLedgeBakeCommandlet.generated.h"
+
+/**
+ * Bakes the AZCLedgeGraph in each given map and saves the map. A graph covering the level's bounds is added to maps that don't have one.
+ * Usage: UnrealEditor-Cmd <Project> -run=ZCLedgeBake -Maps=/Game/Maps/MapA+/Game/Maps/MapB
+ */
+UCLASS()
+class CLIMBING_API UZCLedgeBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UZCLedgeBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool BakeMap(const FString& MapName);
+};
@@ -0,0 +1,374 @@
+#include "Climbing/ZC/ZCLedgeGraph.h"
+#include "Climbing/ZC/ZCClimbNavigation.h"
+#include "Climbing/ZC/ZCClimbProxy.h"
+#include "Climbing/ZC/ZCClimbingCharacter.h"
+#include "Climbing/ZC/ZCClimbingSettings.h"
+#include "Climbing/ZC/ZCTypes.h"
+#include "Climbing/Climbing.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Algo/BinarySearch.h"
+#include "AI/NavigationSystemBase.h"
+#include "AI/Navigation/NavLinkDefinition.h"
+#include "NavigationSystemTypes.h"
+
+static const FIntPoint LedgeDirections[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+AZCLedgeGraph::AZCLedgeGraph()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BakeBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("BakeBounds"));
+	BakeBounds->SetBoxExtent(FVector(2000.f));
+	BakeBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RootComponent = BakeBounds;
+
+	CharacterClass = AZCClimbingCharacter::StaticClass();
+}
+
+void AZCLedgeGraph::SetBakeBounds(const FBox& Bounds)
+{
+	SetActorLocation(Bounds.GetCenter());
+	BakeBounds->SetBoxExtent(Bounds.GetExtent());
+}
+
+FVector AZCLedgeGraph::GetColumnCenter(const FIntPoint& Column, float Z) const
+{
+	return FVector((Column.X + 0.5f) * SampleSpacing, (Column.Y + 0.5f) * SampleSpacing, Z);
+}
+
+uint64 AZCLedgeGraph::ToCellKey(const FVector& Location) const
+{
+	return ToCellKey(FIntVector(
+		FMath::FloorToInt(Location.X / IndexCellSize),
+		FMath::FloorToInt(Location.Y / IndexCellSize),
+		FMath::FloorToInt(Location.Z / IndexCellSize)));
+}
+
+uint64 AZCLedgeGraph::ToCellKey(const FIntVector& Cell) const
+{
+	// 21 bits per axis, biased so negative cells sort below positive ones
+	constexpr int32 Bias = 1 << 20;
+	constexpr uint64 Mask = (1ull << 21) - 1;
+	return ((static_cast<uint64>(Cell.X + Bias) & Mask) << 42) | ((static_cast<uint64>(Cell.Y + Bias) & Mask) << 21) | (static_cast<uint64>(Cell.Z + Bias) & Mask);
+}
+
+void AZCLedgeGraph::Bake()
+{
+	Modify();
+
+	Ledges.Reset();
+	LedgeIndex.Reset();
+	ClimbLinks.Reset();
+	BakedBounds = FBox(ForceInit);
+	bCanRuleOutLedges = false;
+
+	const ACharacter* CharacterDefaults = CharacterClass ? CharacterClass.GetDefaultObject() : nullptr;
+	if (!GetWorld() || !CharacterDefaults || !CharacterDefaults->GetCapsuleComponent())
+		return;
+
+	BakedBounds = BakeBounds->Bounds.GetBox();
+	StandCapsuleRadius = CharacterDefaults->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	StandCapsuleHalfHeight = CharacterDefaults->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	// A top the capsule fits on is at least two radii across, so with columns no further apart than one radius it can't fall between them
+	bCanRuleOutLedges = SampleSpacing <= StandCapsuleRadius;
+	if (!bCanRuleOutLedges)
+		UE_LOG(LogZCClimbing, Warning, TEXT("%s: SampleSpacing %.0f is more than the capsule radius %.0f, ledge climbs will still run the live checks wherever no ledge was baked"),
+			*GetName(), SampleSpacing, StandCapsuleRadius);
+
+	// Climbing queries see the climb proxies rather than the meshes they stand in for, so the bake has to as well
+	const FZCClimbProxyBakeScope ClimbProxies(GetWorld());
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ZCLedgeGraphBake), false, this);
+
+	// One column past the bounds on every side so edges on the border still have a neighbour to compare against
+	const FIntPoint MinColumn(FMath::FloorToInt(BakedBounds.Min.X / SampleSpacing) - 1, FMath::FloorToInt(BakedBounds.Min.Y / SampleSpacing) - 1);
+	const FIntPoint MaxColumn(FMath::FloorToInt(BakedBounds.Max.X / SampleSpacing) + 1, FMath::FloorToInt(BakedBounds.Max.Y / SampleSpacing) + 1);
+
+	TMap<FIntPoint, TArray<float, TInlineAllocator<4>>> Tops;
+	for (int32 Y = MinColumn.Y; Y <= MaxColumn.Y; ++Y)
+		for (int32 X = MinColumn.X; X <= MaxColumn.X; ++X)
+		{
+			const FIntPoint Column(X, Y);
+			TArray<float, TInlineAllocator<4>> ColumnTops;
+			FindWalkableTops(GetColumnCenter(Column, BakedBounds.Max.Z), BakedBounds.Min.Z, ColumnTops, Params);
+
+			if (ColumnTops.Num() > 0)
+				Tops.Add(Column, MoveTemp(ColumnTops));
+		}
+
+	// A walkable top is on a ledge wherever the neighbouring column has nothing walkable at about the same height
+	TArray<FLedgeSample> Samples;
+	for (const TPair<FIntPoint, TArray<float, TInlineAllocator<4>>>& ColumnTops : Tops)
+	{
+		const FIntPoint& Column = ColumnTops.Key;
+		if (Column.X == MinColumn.X || Column.X == MaxColumn.X || Column.Y == MinColumn.Y || Column.Y == MaxColumn.Y)
+			continue;
+
+		for (const float TopZ : ColumnTops.Value)
+			for (int32 Direction = 0; Direction < UE_ARRAY_COUNT(LedgeDirections); ++Direction)
+			{
+				const TArray<float, TInlineAllocator<4>>* NeighbourTops = Tops.Find(Column + LedgeDirections[Direction]);
+				const bool bHasNeighbourTop = NeighbourTops && NeighbourTops->ContainsByPredicate([&](float NeighbourZ) { return FMath::Abs(NeighbourZ - TopZ) < MinLedgeHeight; });
+				if (bHasNeighbourTop)
+					continue;
+
+				FLedgeSample Sample;
+				if (FindLedgeSample(Column, Direction, TopZ, Sample, Params))
+					Samples.Add(Sample);
+			}
+	}
+
+	ChainLedgeSamples(Samples, Params);
+	BuildIndex();
+	BuildClimbLinks(Params);
+
+	FNavigationSystem::UpdateActorData(*this);
+}
+
+void AZCLedgeGraph::FindWalkableTops(const FVector& ColumnTop, float BottomZ, TArray<float, TInlineAllocator<4>>& OutTops, const FCollisionQueryParams& Params) const
+{
+	const float WalkableFloorZ = GetDefault<UCharacterMovementComponent>()->GetWalkableFloorZ();
+	const int32 MaxSteps = 64;
+
+	// Keep tracing down from under each hit to find every surface stacked in the column
+	FVector Start = ColumnTop;
+	for (int32 Step = 0; Step < MaxSteps && Start.Z > BottomZ; ++Step)
+	{
+		FHitResult Hit;
+		if (!GetWorld()->LineTraceSingleByChannel(Hit, Start, FVector(Start.X, Start.Y, BottomZ), UZCClimbingSettings::GetClimbTraceChannel(), Params))
+			return;
+
+		const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		const bool bIsStatic = HitComponent && HitComponent->Mobility == EComponentMobility::Static;
+		if (bIsStatic && !Hit.bStartPenetrating && Hit.ImpactNormal.Z >= WalkableFloorZ)
+			OutTops.Add(Hit.ImpactPoint.Z);
+
+		Start.Z = FMath::Min(Hit.ImpactPoint.Z, Start.Z) - SampleSpacing;
+	}
+}
+
+bool AZCLedgeGraph::FindLedgeSample(const FIntPoint& Column, int32 Direction, float TopZ, FLedgeSample& OutSample, const FCollisionQueryParams& Params) const
+{
+	const FVector Outward = FVector(LedgeDirections[Direction].X, LedgeDirections[Direction].Y, 0.f);
+	const float ProbeDepth = FMath::Min(MinLedgeHeight * 0.5f, 20.f);
+
+	// Trace back in from the open side just under the top to find the wall face
+	const FVector Start = GetColumnCenter(Column + LedgeDirections[Direction], TopZ - ProbeDepth);
+	const FVector End = Start - Outward * SampleSpacing * 1.5f;
+
+	FHitResult WallHit;
+	if (!GetWorld()->LineTraceSingleByChannel(WallHit, Start, End, UZCClimbingSettings::GetClimbTraceChannel(), Params))
+		return false;
+
+	const UPrimitiveComponent* HitComponent = WallHit.GetComponent();
+	if (!HitComponent || HitComponent->Mobility != EComponentMobility::Static)
+		return false;
+
+	const FVector HorizontalNormal = WallHit.ImpactNormal.GetSafeNormal2D();
+	const float VerticalAngleCos = FVector::DotProduct(WallHit.ImpactNormal, HorizontalNormal);
+	if (FMath::IsNearlyZero(VerticalAngleCos) || VerticalAngleCos < FMath::Cos(FMath::DegreesToRadians(MinVerticalDegreesToStartClimbing)))
+		return false;
+
+	OutSample.Column = Column;
+	OutSample.Direction = Direction;
+	OutSample.Location = FVector(WallHit.ImpactPoint.X, WallHit.ImpactPoint.Y, TopZ);
+	OutSample.Normal = HorizontalNormal;
+	return true;
+}
+
+void AZCLedgeGraph::ChainLedgeSamples(const TArray<FLedgeSample>& Samples, const FCollisionQueryParams& Params)
+{
+	// Samples in neighbouring columns along the edge, facing the same way at about the same height, belong to the same ledge
+	TMap<FIntVector, TArray<int32, TInlineAllocator<2>>> SamplesByColumn;
+	for (int32 SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
+	{
+		const FLedgeSample& Sample = Samples[SampleIndex];
+		SamplesByColumn.FindOrAdd(FIntVector(Sample.Column.X, Sample.Column.Y, Sample.Direction)).Add(SampleIndex);
+	}
+
+	TBitArray<> Visited(false, Samples.Num());
+	auto FindNextInChain = [&](int32 SampleIndex, int32 Step) -> int32
+	{
+		const FLedgeSample& Sample = Samples[SampleIndex];
+		const FIntPoint Along = LedgeDirections[Sample.Direction].X != 0 ? FIntPoint(0, Step) : FIntPoint(Step, 0);
+		const FIntPoint NextColumn = Sample.Column + Along;
+
+		if (const TArray<int32, TInlineAllocator<2>>* Candidates = SamplesByColumn.Find(FIntVector(NextColumn.X, NextColumn.Y, Sample.Direction)))
+			for (const int32 Candidate : *Candidates)
+				if (!Visited[Candidate] && FMath::Abs(Samples[Candidate].Location.Z - Sample.Location.Z) < MinLedgeHeight * 0.5f)
+					return Candidate;
+
+		return INDEX_NONE;
+	};
+
+	for (int32 SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
+	{
+		if (Visited[SampleIndex])
+			continue;
+
+		// Back up to the start of the chain, then walk it forwards
+		int32 ChainStart = SampleIndex;
+		for (int32 Steps = 0; Steps < Samples.Num(); ++Steps)
+		{
+			const int32 Previous = FindNextInChain(ChainStart, -1);
+			if (Previous == INDEX_NONE || Previous == SampleIndex)
+				break;
+			ChainStart = Previous;
+		}
+
+		FZCLedge& Ledge = Ledges.AddDefaulted_GetRef();
+		FVector NormalSum = FVector::ZeroVector;
+		for (int32 Current = ChainStart; Current != INDEX_NONE; Current = FindNextInChain(Current, 1))
+		{
+			Visited[Current] = true;
+			Ledge.Points.Add(MakeLedgePoint(Samples[Current], Params));
+			NormalSum += Samples[Current].Normal;
+		}
+
+		Ledge.Normal = NormalSum.GetSafeNormal2D();
+	}
+}
+
+FZCLedgePoint AZCLedgeGraph::MakeLedgePoint(const FLedgeSample& Sample, const FCollisionQueryParams& Params) const
+{
+	FZCLedgePoint Point;
+	Point.Location = Sample.Location;
+
+	const float WalkableFloorZ = GetDefault<UCharacterMovementComponent>()->GetWalkableFloorZ();
+	const FVector StandGround = Sample.Location - Sample.Normal * StandInset;
+	const FVector GroundStart = StandGround + FVector::UpVector * StandCapsuleHalfHeight;
+	const FVector GroundEnd = StandGround - FVector::UpVector * MinLedgeHeight;
+
+	FHitResult GroundHit;
+	if (!GetWorld()->LineTraceSingleByChannel(GroundHit, GroundStart, GroundEnd, UZCClimbingSettings::GetClimbTraceChannel(), Params) || GroundHit.ImpactNormal.Z < WalkableFloorZ)
+	{
+		Point.StandLocation = StandGround + FVector::UpVector * StandCapsuleHalfHeight;
+		return Point;
+	}
+
+	// Lift off the ground a little so the clearance check doesn't touch the floor it's standing on
+	Point.StandLocation = GroundHit.ImpactPoint + FVector::UpVector * (StandCapsuleHalfHeight + 2.f);
+
+	const FCollisionShape StandCapsule = FCollisionShape::MakeCapsule(StandCapsuleRadius, StandCapsuleHalfHeight);
+	Point.bCanStand = !GetWorld()->OverlapBlockingTestByChannel(Point.StandLocation, FQuat::Identity, ECC_Pawn, StandCapsule, Params);
+	return Point;
+}
+
+void AZCLedgeGraph::BuildIndex()
+{
+	for (int32 LedgeIndexInGraph = 0; LedgeIndexInGraph < Ledges.Num(); ++LedgeIndexInGraph)
+		for (int32 PointIndex = 0; PointIndex < Ledges[LedgeIndexInGraph].Points.Num(); ++PointIndex)
+		{
+			FZCLedgeIndexEntry& Entry = LedgeIndex.AddDefaulted_GetRef();
+			Entry.CellKey = ToCellKey(Ledges[LedgeIndexInGraph].Points[PointIndex].Location);
+			Entry.Ledge = LedgeIndexInGraph;
+			Entry.Point = PointIndex;
+		}
+
+	LedgeIndex.Sort([](const FZCLedgeIndexEntry& A, const FZCLedgeIndexEntry& B) { return A.CellKey < B.CellKey; });
+}
+
+void AZCLedgeGraph::BuildClimbLinks(const FCollisionQueryParams& Params)
+{
+	const float WalkableFloorZ = GetDefault<UCharacterMovementComponent>()->GetWalkableFloorZ();
+	const int32 PointsPerLink = FMath::Max(1, FMath::RoundToInt(ClimbLinkSpacing / SampleSpacing));
+
+	for (int32 LedgeIndexInGraph = 0; LedgeIndexInGraph < Ledges.Num(); ++LedgeIndexInGraph)
+	{
+		const FZCLedge& Ledge = Ledges[LedgeIndexInGraph];
+
+		// Start half a spacing in so short ledges still get a link in the middle
+		for (int32 PointIndex = FMath::Min(PointsPerLink / 2, Ledge.Points.Num() - 1); PointIndex < Ledge.Points.Num(); PointIndex += PointsPerLink)
+		{
+			const FZCLedgePoint& Point = Ledge.Points[PointIndex];
+			if (!Point.bCanStand)
+				continue;
+
+			// Find the ground at the bottom of the wall
+			const FVector BaseStart = Point.Location + Ledge.Normal * ClimbLinkBaseOffset;
+			const FVector BaseEnd = BaseStart - FVector::UpVector * MaxClimbLinkHeight;
+
+			FHitResult BaseHit;
+			if (!GetWorld()->LineTraceSingleByChannel(BaseHit, BaseStart, BaseEnd, UZCClimbingSettings::GetClimbTraceChannel(), Params) || BaseHit.ImpactNormal.Z < WalkableFloorZ)
+				continue;
+			if (Point.Location.Z - BaseHit.ImpactPoint.Z < MinLedgeHeight)
+				continue;
+
+			FZCClimbLink& Link = ClimbLinks.AddDefaulted_GetRef();
+			Link.Base = BaseHit.ImpactPoint;
+			Link.Top = Point.StandLocation - FVector::UpVector * StandCapsuleHalfHeight;
+			Link.WallNormal = Ledge.Normal;
+			Link.Ledge = LedgeIndexInGraph;
+			Link.Point = PointIndex;
+		}
+	}
+}
+
+const FZCClimbLink* AZCLedgeGraph::FindClimbLink(const FVector& Start, const FVector& End, float Tolerance) const
+{
+	const float ToleranceSq = FMath::Square(Tolerance);
+	for (const FZCClimbLink& Link : ClimbLinks)
+		if (FVector::DistSquared(Link.Base, Start) <= ToleranceSq && FVector::DistSquared(Link.Top, End) <= ToleranceSq)
+			return &Link;
+
+	return nullptr;
+}
+
+void AZCLedgeGraph::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	// Nav links are relative to the actor
+	const FTransform& Transform = GetActorTransform();
+
+	TArray<FNavigationLink> NavLinks;
+	NavLinks.Reserve(ClimbLinks.Num());
+	for (const FZCClimbLink& Link : ClimbLinks)
+	{
+		FNavigationLink& NavLink = NavLinks.Emplace_GetRef(Transform.InverseTransformPosition(Link.Base), Transform.InverseTransformPosition(Link.Top));
+		NavLink.Direction = ENavLinkDirection::LeftToRight;
+		NavLink.SetAreaClass(UZCNavArea_Climb::StaticClass());
+	}
+
+	NavigationHelper::ProcessNavLinkAndAppend(&Data.Modifiers, this, NavLinks);
+}
+
+FBox AZCLedgeGraph::GetNavigationBounds() const
+{
+	return BakedBounds;
+}
+
+const FZCLedgePoint* AZCLedgeGraph::FindLedge(const FVector& Location, const FVector& Forward, float Reach, float MinZ, float MaxZ, float MinFacingCos) const
+{
+	const FIntVector MinCell(FMath::FloorToInt((Location.X - Reach) / IndexCellSize), FMath::FloorToInt((Location.Y - Reach) / IndexCellSize), FMath::FloorToInt(MinZ / IndexCellSize));
+	const FIntVector MaxCell(FMath::FloorToInt((Location.X + Reach) / IndexCellSize), FMath::FloorToInt((Location.Y + Reach) / IndexCellSize), FMath::FloorToInt(MaxZ / IndexCellSize));
+
+	const FZCLedgePoint* Closest = nullptr;
+	float ClosestDistanceSq = FMath::Square(Reach);
+
+	for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				const uint64 CellKey = ToCellKey(FIntVector(X, Y, Z));
+				for (int32 Entry = Algo::LowerBoundBy(LedgeIndex, CellKey, &FZCLedgeIndexEntry::CellKey); Entry < LedgeIndex.Num() && LedgeIndex[Entry].CellKey == CellKey; ++Entry)
+				{
+					const FZCLedge& Ledge = Ledges[LedgeIndex[Entry].Ledge];
+					const FZCLedgePoint& Point = Ledge.Points[LedgeIndex[Entry].Point];
+
+					const FVector Delta = Point.Location - Location;
+					const float DistanceSq = Delta.SizeSquared2D();
+					if (DistanceSq > ClosestDistanceSq || Point.Location.Z < MinZ || Point.Location.Z > MaxZ)
+						continue;
+					if (FVector::DotProduct(FVector(Delta.X, Delta.Y, 0.f), Forward) < 0.f || FVector::DotProduct(Forward, -Ledge.Normal) < MinFacingCos)
+						continue;
+
+					Closest = &Point;
+					ClosestDistanceSq = DistanceSq;
+				}
+			}
+
+	return Closest;
+}
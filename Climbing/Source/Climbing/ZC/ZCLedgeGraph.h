@@ -0,0 +1,199 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AI/Navigation/NavRelevantInterface.h"
+#include "ZCLedgeGraph.generated.h"
+
+USTRUCT()
+struct FZCLedgePoint
+{
+	GENERATED_BODY()
+
+	// Top of the wall, right on the edge
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	// Where the climbing capsule ends up after climbing over the edge
+	UPROPERTY()
+	FVector StandLocation = FVector::ZeroVector;
+
+	// Walkable ground under StandLocation and room for the capsule there
+	UPROPERTY()
+	bool bCanStand = false;
+};
+
+/**
+ * A walkable edge on top of a climbable wall, stored as a polyline along the edge
+ */
+USTRUCT()
+struct FZCLedge
+{
+	GENERATED_BODY()
+
+	// Horizontal normal of the wall below the edge, pointing away from the walkable top
+	UPROPERTY()
+	FVector Normal = FVector::ZeroVector;
+
+	UPROPERTY()
+	TArray<FZCLedgePoint> Points;
+};
+
+/**
+ * A climbable stretch of wall between walkable ground at its base and a ledge at its top. Exported to the navmesh as a one way nav link.
+ */
+USTRUCT()
+struct FZCClimbLink
+{
+	GENERATED_BODY()
+
+	// Walkable ground in front of the wall
+	UPROPERTY()
+	FVector Base = FVector::ZeroVector;
+
+	// Walkable ground past the ledge, where the character stands after climbing up
+	UPROPERTY()
+	FVector Top = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector WallNormal = FVector::ZeroVector;
+
+	UPROPERTY()
+	int32 Ledge = INDEX_NONE;
+	UPROPERTY()
+	int32 Point = INDEX_NONE;
+};
+
+USTRUCT()
+struct FZCLedgeIndexEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint64 CellKey = 0;
+	UPROPERTY()
+	int32 Ledge = INDEX_NONE;
+	UPROPERTY()
+	int32 Point = INDEX_NONE;
+};
+
+/**
+ * Walkable ledges extracted from the static geometry inside its bounds, baked ahead of time by Bake() or the ZCLedgeBake
+ * commandlet so ledge climbs can be checked without scene queries. Ledge points are indexed by cell in a sorted array,
+ * so a lookup is a binary search per cell. Like AZCClimbGrid, anything that isn't static mobility has to go through the live checks.
+ *
+ * Ledges with walkable ground at the bottom of their wall also become climb links, which are added to the navmesh so AI paths can climb.
+ */
+UCLASS()
+class CLIMBING_API AZCLedgeGraph : public AActor, public INavRelevantInterface
+{
+	GENERATED_BODY()
+
+public:
+	AZCLedgeGraph();
+
+	// Rebuilds the ledges from whatever static geometry is inside BakeBounds, tracing climb proxies in place of their meshes. Rebake after regenerating proxies.
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Climbing")
+	void Bake();
+
+	void SetBakeBounds(const FBox& Bounds);
+
+	bool Covers(const FVector& Location) const { return BakedBounds.IsValid && BakedBounds.IsInsideOrOn(Location); }
+	// Whether the columns were close enough that every ledge a character can stand on got sampled, so finding none means there isn't one
+	bool CanRuleOutLedges() const { return bCanRuleOutLedges; }
+	int32 GetNumLedges() const { return Ledges.Num(); }
+	int32 GetNumLedgePoints() const { return LedgeIndex.Num(); }
+	const TArray<FZCClimbLink>& GetClimbLinks() const { return ClimbLinks; }
+
+	// Climb link running from near Start to near End, if there is one
+	const FZCClimbLink* FindClimbLink(const FVector& Start, const FVector& End, float Tolerance) const;
+
+	// INavRelevantInterface
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual FBox GetNavigationBounds() const override;
+	virtual bool IsNavigationRelevant() const override { return !ClimbLinks.IsEmpty(); }
+
+	/**
+	 * Closest ledge point in front of Location, no further than Reach horizontally, with its top between MinZ and MaxZ,
+	 * on a wall facing back at Forward within MinFacingCos. Returns null if there isn't one.
+	 */
+	const FZCLedgePoint* FindLedge(const FVector& Location, const FVector& Forward, float Reach, float MinZ, float MaxZ, float MinFacingCos) const;
+
+protected:
+	UPROPERTY(Category = "Climbing", VisibleAnywhere)
+	class UBoxComponent* BakeBounds;
+
+	// Distance between the columns sampled for walkable tops, and so between points along each ledge. No more than the character's
+	// capsule radius, or tops a character could just stand on may fall between columns and the live checks have to cover for the graph.
+	UPROPERTY(Category = "Climbing", EditAnywhere, meta = (ClampMin = "5.0", ClampMax = "100.0"))
+	float SampleSpacing = 25.f;
+
+	// How far the ground has to drop past a walkable top for the edge to count as a ledge
+	UPROPERTY(Category = "Climbing", EditAnywhere, meta = (ClampMin = "10.0", ClampMax = "500.0"))
+	float MinLedgeHeight = 60.f;
+
+	// Should match the movement component's MinVerticalDegreesToStartClimbing
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float MinVerticalDegreesToStartClimbing = 45;
+
+	// Character whose standing capsule the stand up clearance is checked with
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	TSubclassOf<class ACharacter> CharacterClass;
+	// How far past the edge the character stands after climbing up
+	UPROPERTY(Category = "Climbing", EditAnywhere)
+	float StandInset = 75.f;
+
+	// Distance along a ledge between climb links
+	UPROPERTY(Category = "Climbing|Navigation", EditAnywhere, meta = (ClampMin = "25.0", ClampMax = "2000.0"))
+	float ClimbLinkSpacing = 200.f;
+	// Tallest wall AI will path up
+	UPROPERTY(Category = "Climbing|Navigation", EditAnywhere, meta = (ClampMin = "50.0", ClampMax = "10000.0"))
+	float MaxClimbLinkHeight = 1500.f;
+	// How far out from the wall the base of a climb link is
+	UPROPERTY(Category = "Climbing|Navigation", EditAnywhere, meta = (ClampMin = "10.0", ClampMax = "200.0"))
+	float ClimbLinkBaseOffset = 60.f;
+
+	// Size of the cells ledge points are indexed by
+	UPROPERTY(Category = "Climbing", EditAnywhere, meta = (ClampMin = "25.0", ClampMax = "1000.0"))
+	float IndexCellSize = 100.f;
+
+	UPROPERTY()
+	FBox BakedBounds = FBox(ForceInit);
+
+	UPROPERTY()
+	bool bCanRuleOutLedges = false;
+
+	UPROPERTY()
+	TArray<FZCLedge> Ledges;
+
+	// Sorted by CellKey
+	UPROPERTY()
+	TArray<FZCLedgeIndexEntry> LedgeIndex;
+
+	UPROPERTY()
+	TArray<FZCClimbLink> ClimbLinks;
+
+private:
+	// Read from CharacterClass at the start of every bake
+	float StandCapsuleRadius = 0.f;
+	float StandCapsuleHalfHeight = 0.f;
+
+	struct FLedgeSample
+	{
+		FIntPoint Column;
+		int32 Direction;
+		FVector Location;
+		FVector Normal;
+	};
+
+	void FindWalkableTops(const FVector& ColumnTop, float BottomZ, TArray<float, TInlineAllocator<4>>& OutTops, const FCollisionQueryParams& Params) const;
+	bool FindLedgeSample(const FIntPoint& Column, int32 Direction, float TopZ, FLedgeSample& OutSample, const FCollisionQueryParams& Params) const;
+	void ChainLedgeSamples(const TArray<FLedgeSample>& Samples, const FCollisionQueryParams& Params);
+	FZCLedgePoint MakeLedgePoint(const FLedgeSample& Sample, const FCollisionQueryParams& Params) const;
+	void BuildIndex();
+	void BuildClimbLinks(const FCollisionQueryParams& Params);
+
+	FVector GetColumnCenter(const FIntPoint& Column, float Z) const;
+	uint64 ToCellKey(const FVector& Location) const;
+	uint64 ToCellKey(const FIntVector& Cell) const;
+};
@@ -2,6 +2,10 @@
 
 #include "UObject/ObjectMacros.h"
 
+// Trace channel set up as "Climbable" in DefaultEngine.ini. Everything blocks it unless its collision says otherwise, so meshes opt out
+// with the NoClimb profile or by ignoring the channel. This is only the default, UZCClimbingSettings holds the channel actually traced.
+#define ECC_ZCClimbable ECC_GameTraceChannel1
+
 UENUM(BlueprintType)
 enum ECustomMovementMode
 {